@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "AST.hpp"
 #include <BigInt.hpp> // snarklib
@@ -22,6 +23,8 @@ namespace snarkfront {
 //
 // - Alg_bool for predicate
 // - Alg_BigInt for scalar field of GMP big numbers
+// - Alg_Fr for scalar field elements (no integer value or bit split)
+// - Alg_uint8 for 8-bit bytes
 // - Alg_uint32 for 32-bit words
 // - Alg_uint64 for 64-bit words
 //
@@ -37,23 +40,35 @@ Alg_bool = Alg<bool,
                LogicalOps,
                EqualityCmp>;
 
-template <typename FR> using
-Alg_BigInt = Alg<snarklib::BigInt<2>, // 128 bits on x86-64
+template <typename FR, mp_size_t N = 2> using
+Alg_BigInt = Alg<snarklib::BigInt<N>, // 64 * N bits on x86-64
                  FR,
                  ScalarOps,
                  ScalarCmp>;
 
+template <typename FR> using
+Alg_Fr = Alg<FR,
+             FR,
+             ScalarOps,
+             ScalarCmp>;
+
+template <typename FR> using
+Alg_uint8 = Alg<std::uint8_t,
+                FR,
+                BitwiseOps,
+                ScalarCmp>;
+
 template <typename FR> using
 Alg_uint32 = Alg<std::uint32_t,
                  FR,
                  BitwiseOps,
-                 EqualityCmp>;
+                 ScalarCmp>;
 
 template <typename FR> using
 Alg_uint64 = Alg<std::uint64_t,
                  FR,
                  BitwiseOps,
-                 EqualityCmp>;
+                 ScalarCmp>;
 
 ////////////////////////////////////////////////////////////////////////////////
 // algebra parameter
@@ -86,7 +101,7 @@ public:
 #endif
 
         m_value = VAL(a);
-        m_witness = FR(valueToString(VAL(a)));
+        m_witness = valueToWitness(VAL(a));
         m_splitBits = valueBits(VAL(a));
 
         initTerms(true);
@@ -101,7 +116,7 @@ public:
     template <typename T>
     Alg(const T& a, const bool blessed)
         : m_value(a),
-          m_witness(valueToString(VAL(a))),
+          m_witness(valueToWitness(VAL(a))),
           m_splitBits(valueBits(VAL(a)))
     {
         initTerms(blessed);
@@ -150,10 +165,15 @@ public:
     // field constructors accept strings
     static std::string valueToString(const VAL& a) {
         std::stringstream ss;
-        ss << a;
+        ss << StreamType(a);
         return ss.str();
     }
 
+    // field witness from value, machine integers without a decimal string
+    static FR valueToWitness(const VAL& a) {
+        return witnessFrom(a);
+    }
+
     // called from AST Variable overloaded assignment operator
     static Alg
     assignEval(const AST_Var<Alg>& lhs, const AST_Node<Alg>& rhs) {
@@ -192,7 +212,7 @@ public:
                             C.result().r1Terms());
     }
 
-    // type conversion to and between 32-bit and 64-bit words
+    // type conversion to and between 8-bit, 32-bit and 64-bit words
     template <typename U>
     static U xwordOp(const AST_Node<Alg>& src, const U& dummy)
     {
@@ -210,18 +230,39 @@ public:
                 : 0; // all bits clear
 
         } else {
-            // source is 32-bit or 64-bit word
+            // source is 8-bit, 32-bit or 64-bit word
             uvalue = E.result().value();
         }
 
+        // ADDMOD and MULMOD results have bits above the source word
+        const auto xfit = rank1_xword(x, sizeBits(E.result().value()));
+
         // convert result of foreign algebraic source type to target type
         return U(uvalue,
-                 valueToString(uvalue),
+                 U::valueToWitness(uvalue),
                  valueBits(uvalue),
-                 rank1_xword(x, sizeBits(uvalue)));
+                 rank1_xword(xfit, sizeBits(uvalue)));
     }
 
 private:
+    // one field addition per non-zero byte
+    template <typename T>
+    static FR witnessFrom(const T& a) {
+        return TL<PowersOf2<FR>>::singleton()->getNumber(a);
+    }
+
+    // big integers parse the decimal string (one addition per byte was
+    // slower for full width values)
+    template <mp_size_t N>
+    static FR witnessFrom(const snarklib::BigInt<N>& a) {
+        return FR(valueToString(a));
+    }
+
+    // bytes are streamed as numbers, not characters
+    typedef typename std::conditional<std::is_same<VAL, std::uint8_t>::value,
+                                      unsigned int,
+                                      VAL>::type StreamType;
+
     VAL valueFromWitness(const R1Cowitness<FR>& input) const {
         const std::size_t peekID = TL<R1C<FR>>::singleton()->counterID();
 #ifdef USE_ASSERT
@@ -230,13 +271,13 @@ private:
 
         std::stringstream ss(input[peekID]);
 
-        VAL value;
+        StreamType value;
         ss >> value;
 #ifdef USE_ASSERT
         assert(!!ss);
 #endif
 
-        return value;
+        return VAL(value);
     }
 
     void initTerms(const bool blessed) {
@@ -1,7 +1,10 @@
 #ifndef _SNARKFRONT_ALG_BIGINT_HPP_
 #define _SNARKFRONT_ALG_BIGINT_HPP_
 
+#include <algorithm>
+#include <cassert>
 #include <gmp.h>
+#include <vector>
 #include "Alg.hpp"
 #include "BigIntOps.hpp"
 
@@ -10,197 +13,572 @@ namespace snarkfront {
 ////////////////////////////////////////////////////////////////////////////////
 // Alg_BigInt
 //
+// Circuit inputs and constants are bits. Operator results are limbs,
+// one rank-1 term for each GMP limb (64 bits on x86-64), range checked
+// by bit decomposition. Big integers wider than the scalar field (e.g.
+// 256 bits) never wrap around the field modulus.
+//
+// A range check (evalRange) returns fewer bits than the full width.
+// Comparisons of these narrow values decompose only width + 1 bits.
+//
+
+// narrow comparison if 2^(width + 1) is less than the field modulus
+// (BN128 and Edwards scalar fields are both wider than 128 + 1 bits)
+const std::size_t BIGINT_NARROW_BITS = 128;
+
+// argument is bit representation (input, constant, or range checked)
+template <typename FR, mp_size_t N>
+bool isBits(const Alg_BigInt<FR, N>& arg) {
+    return arg.r1Terms().size() == arg.splitBits().size();
+}
+
+// width of bit representation, constants are no wider than the value
+template <typename FR, mp_size_t N>
+std::size_t widthBits(const Alg_BigInt<FR, N>& arg)
+{
+    for (const auto& t : arg.r1Terms()) {
+        if (t.isVariable())
+            return arg.splitBits().size();
+    }
+
+    std::size_t width = 1;
+    for (std::size_t i = 0; i < arg.splitBits().size(); ++i) {
+        if (arg.splitBits()[i])
+            width = i + 1;
+    }
 
+    return width;
+}
+
+// finite field witness of one limb
 template <typename FR>
-void evalStackOp(std::stack<Alg_BigInt<FR>>& S, const ScalarOps op)
+FR limbWitness(const mp_limb_t a) {
+    return TL<PowersOf2<FR>>::singleton()->getNumber(a);
+}
+
+// argument as limbs, converts bits as necessary
+template <typename FR, mp_size_t N>
+std::vector<snarklib::R1Term<FR>> argLimbs(const Alg_BigInt<FR, N>& arg)
+{
+    typedef typename Alg_BigInt<FR, N>::R1T R1T;
+    auto& RS = TL<R1C<FR>>::singleton();
+
+    const std::vector<R1T>& terms = arg.r1Terms();
+
+    // operator result is already limbs
+    if (! isBits(arg)) return terms;
+
+#ifdef USE_ASSERT
+    assert(terms.size() <= N * GMP_NUMB_BITS);
+#endif
+
+    std::vector<R1T> v;
+    v.reserve(N);
+
+    for (std::size_t i = 0; i < N; ++i) {
+        const std::size_t
+            low = std::min(GMP_NUMB_BITS * i, terms.size()),
+            high = std::min(GMP_NUMB_BITS * (i + 1), terms.size());
+
+        if (low == high) {
+            // limb above range checked width
+            v.emplace_back(RS->createConstant(FR::zero()));
+
+        } else {
+            const std::vector<R1T> bits(terms.begin() + low,
+                                        terms.begin() + high);
+
+            v.emplace_back(
+                RS->bitsToWitness(bits, limbWitness<FR>(arg.value().data()[i])));
+        }
+    }
+
+    return v;
+}
+
+// range check of a result limb
+template <typename FR>
+void rangeLimb(const snarklib::R1Term<FR>& z, const mp_limb_t a)
+{
+    if (z.isVariable()) {
+        TL<R1C<FR>>::singleton()->witnessToBits(z, valueBits(a));
+    }
+}
+
+// addition or subtraction with carry (or borrow) chain
+// carry out of top limb is returned if keepCarry, otherwise it must be zero
+template <typename FR, mp_size_t N>
+snarklib::R1Term<FR> limbsCarry(const ScalarOps op,
+                                const std::vector<snarklib::R1Term<FR>>& x,
+                                const std::vector<snarklib::R1Term<FR>>& y,
+                                const snarklib::BigInt<N>& xvalue,
+                                const snarklib::BigInt<N>& yvalue,
+                                std::vector<snarklib::R1Term<FR>>& z,
+                                const bool keepCarry,
+                                bool& carryValue)
+{
+    typedef snarklib::R1Term<FR> R1T;
+    auto& RS = TL<R1C<FR>>::singleton();
+    auto& POW2 = TL<PowersOf2<FR>>::singleton();
+
+    const bool isADD = (ScalarOps::ADD == op);
+#ifdef USE_ASSERT
+    assert(isADD || ScalarOps::SUB == op);
+#endif
+
+    // ADD: x + y + c - 2^64 * cnext == z
+    // SUB: x - y - c + 2^64 * cnext == z
+    const FR sign = isADD ? FR::one() : FR::zero() - FR::one();
+    const std::vector<FR> coeffs = {
+        FR::one(),
+        sign,
+        sign,
+        (FR::zero() - sign) * POW2->lookUp(GMP_NUMB_BITS) };
+
+    z.clear();
+    z.reserve(N);
+
+    R1T c; // no carry into first limb
+    bool cvalue = false;
+
+    for (mp_size_t i = 0; i < N; ++i) {
+        const mp_limb_t
+            a = xvalue.data()[i],
+            b = yvalue.data()[i];
+
+        mp_limb_t zlimb;
+        bool cout;
+        if (isADD) {
+            const mp_limb_t t = a + b;
+            zlimb = t + cvalue;
+            cout = (t < a) || (zlimb < t);
+        } else {
+            const mp_limb_t t = a - b;
+            zlimb = t - cvalue;
+            cout = (a < b) || (t < mp_limb_t(cvalue));
+        }
+
+        const bool isVar =
+            x[i].isVariable() || y[i].isVariable() || c.isVariable();
+
+        // carry out of top limb is overflow
+        R1T cnext;
+        if (i < N - 1 || keepCarry) {
+            cnext = RS->createTerm(boolTo<FR>(cout), isVar);
+            if (isVar) RS->addBooleanity(cnext);
+
+        } else {
+#ifdef USE_ASSERT
+            assert(! cout);
+#endif
+        }
+
+        const R1T zi = RS->linearResult({ x[i], y[i], c, cnext },
+                                        coeffs,
+                                        limbWitness<FR>(zlimb));
+        rangeLimb(zi, zlimb);
+        z.emplace_back(zi);
+
+        c = cnext;
+        cvalue = cout;
+    }
+
+    carryValue = cvalue;
+    return c;
+}
+
+// schoolbook multiplication with column carries
+template <typename FR, mp_size_t N>
+std::vector<snarklib::R1Term<FR>> limbsMUL(const std::vector<snarklib::R1Term<FR>>& x,
+                                           const std::vector<snarklib::R1Term<FR>>& y,
+                                           const snarklib::BigInt<N>& xvalue,
+                                           const snarklib::BigInt<N>& yvalue)
+{
+    typedef snarklib::R1Term<FR> R1T;
+    auto& RS = TL<R1C<FR>>::singleton();
+    auto& POW2 = TL<PowersOf2<FR>>::singleton();
+
+    // column carry is less than (N + 1) * 2^64
+    std::size_t carryBits = GMP_NUMB_BITS + 1;
+    for (mp_size_t n = N; n; n >>= 1) ++carryBits;
+
+    const FR base = POW2->lookUp(GMP_NUMB_BITS);
+
+    std::vector<R1T> z;
+    z.reserve(N);
+
+    R1T c; // no carry into first column
+    snarklib::BigInt<2> cvalue = snarklib::BigInt<2>::zero();
+
+    for (mp_size_t k = 0; k < N; ++k) {
+        std::vector<R1T> terms;
+        std::vector<FR> coeffs;
+        terms.reserve(k + 3);
+        coeffs.reserve(k + 3);
+
+        // column sum accumulates carry from previous column
+        mp_limb_t accum[3] = { cvalue.data()[0], cvalue.data()[1], 0 };
+
+        for (mp_size_t i = 0; i <= k; ++i) {
+            const mp_size_t j = k - i;
+
+            snarklib::BigInt<2> p;
+            mpn_mul_n(p.data(), xvalue.data() + i, yvalue.data() + j, 1);
+            mpn_add(accum, accum, 3, p.data(), 2);
+
+            terms.emplace_back(
+                RS->createResult(ScalarOps::MUL, x[i], y[j], POW2->getNumber(p)));
+            coeffs.emplace_back(FR::one());
+        }
+
+        terms.emplace_back(c);
+        coeffs.emplace_back(FR::one());
+
+        bool isVar = false;
+        for (const auto& t : terms) {
+            if (t.isVariable())
+                isVar = true;
+        }
+
+        const mp_limb_t zlimb = accum[0];
+        cvalue.data()[0] = accum[1];
+        cvalue.data()[1] = accum[2];
+
+        // carry out of top column is overflow
+        R1T cnext;
+        if (k < N - 1) {
+            cnext = RS->createTerm(POW2->getNumber(cvalue), isVar);
+            if (isVar) {
+                std::vector<int> cbits = valueBits(cvalue);
+                cbits.resize(carryBits);
+                RS->witnessToBits(cnext, cbits);
+            }
+
+        } else {
+#ifdef USE_ASSERT
+            assert(0 == accum[1] && 0 == accum[2]);
+#endif
+        }
+
+        terms.emplace_back(cnext);
+        coeffs.emplace_back(FR::zero() - base);
+
+        const R1T zk = RS->linearResult(terms, coeffs, limbWitness<FR>(zlimb));
+        rangeLimb(zk, zlimb);
+        z.emplace_back(zk);
+
+        c = cnext;
+    }
+
+    // products above the top column must be zero (overflow)
+    for (mp_size_t i = 1; i < N; ++i) {
+        RS->addZeroProduct(x[i],
+                           std::vector<R1T>(y.begin() + (N - i), y.end()));
+    }
+
+    return z;
+}
+
+// range check, argument becomes bit representation of width
+template <typename FR, mp_size_t N>
+void evalRange(Alg_BigInt<FR, N>& X, const std::size_t width)
 {
-    typedef typename Alg_BigInt<FR>::ValueType Value;
-    typedef typename Alg_BigInt<FR>::R1T R1T;
+    typedef typename Alg_BigInt<FR, N>::ValueType Value;
+    typedef typename Alg_BigInt<FR, N>::R1T R1T;
     auto& RS = TL<R1C<FR>>::singleton();
 
+    const Value xvalue = X.value();
+    const std::vector<int> xbits = valueBits(xvalue);
+    const std::vector<R1T>& x = X.r1Terms();
+
+#ifdef USE_ASSERT
+    assert(0 < width && width <= sizeBits(xvalue));
+    for (std::size_t i = width; i < xbits.size(); ++i)
+        assert(! xbits[i]);
+#endif
+
+    std::vector<R1T> z;
+    z.reserve(width);
+
+    if (isBits(X)) {
+        // high bits must be clear
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            if (i < width) {
+                z.emplace_back(x[i]);
+            } else if (x[i].isVariable()) {
+                RS->setFalse(x[i]);
+            }
+        }
+
+    } else {
+        // split limbs below width, limbs above width must be zero
+        for (std::size_t i = 0; i < N; ++i) {
+            const std::size_t low = GMP_NUMB_BITS * i;
+
+            if (low < width) {
+                const std::size_t high = std::min(low + GMP_NUMB_BITS, width);
+                const std::vector<int> limbSplit(xbits.begin() + low,
+                                                 xbits.begin() + high);
+
+                for (const auto& b : RS->witnessToBits(x[i], limbSplit))
+                    z.emplace_back(b);
+
+            } else if (x[i].isVariable()) {
+                RS->setFalse(x[i]);
+            }
+        }
+    }
+
+    X = Alg_BigInt<FR, N>(xvalue,
+                          X.witness(),
+                          std::vector<int>(xbits.begin(), xbits.begin() + width),
+                          z);
+}
+
+// comparison of range checked bit representations
+template <typename FR, mp_size_t N>
+snarklib::R1Term<FR> narrowCmp(const ScalarCmp op,
+                               const Alg_BigInt<FR, N>& L,
+                               const Alg_BigInt<FR, N>& R,
+                               const bool result)
+{
+    typedef typename Alg_BigInt<FR, N>::ValueType Value;
+    typedef typename Alg_BigInt<FR, N>::R1T R1T;
+    auto& RS = TL<R1C<FR>>::singleton();
+    auto& POW2 = TL<PowersOf2<FR>>::singleton();
+
+    if (ScalarCmp::EQ == op || ScalarCmp::NEQ == op) {
+        const FR
+            xwitness = POW2->getNumber(L.splitBits()),
+            ywitness = POW2->getNumber(R.splitBits());
+
+        return RS->scalarEquality(op,
+                                  RS->bitsToWitness(L.r1Terms(), xwitness),
+                                  RS->bitsToWitness(R.r1Terms(), ywitness),
+                                  xwitness - ywitness,
+                                  result);
+    }
+
+    // x >= y if and only if bit at width of 2^width + x - y is set
+    // (for GT and LE, y >= x)
+    const bool interchangeXY = (ScalarCmp::GT == op || ScalarCmp::LE == op);
+    const auto& A = interchangeXY ? R : L;
+    const auto& B = interchangeXY ? L : R;
+
+    const std::size_t width = std::max(widthBits(A), widthBits(B));
+
+    // low bits of 2^width + a - b are a - b modulo 2^width
+    Value diff;
+    mpn_sub_n(diff.data(), A.value().data(), B.value().data(), N);
+    std::vector<int> dbits = valueBits(diff);
+    dbits.resize(width);
+    dbits.push_back(! (A.value() < B.value()));
+
+    const R1T ge = RS->greaterEqualBits(A.r1Terms(), B.r1Terms(), dbits);
+
+    // LT and GT are complement
+    return (ScalarCmp::GE == op || ScalarCmp::LE == op)
+        ? ge
+        : RS->createResult(LogicalOps::CMPLMNT, ge, ge, boolTo<FR>(result));
+}
+
+// quotient q is a witness hint, checked by x - q * y == r and r < y
+// (no long division in the circuit, y must not be zero)
+template <typename FR, mp_size_t N>
+std::vector<snarklib::R1Term<FR>> limbsDIV(const std::vector<snarklib::R1Term<FR>>& x,
+                                           const std::vector<snarklib::R1Term<FR>>& y,
+                                           const snarklib::BigInt<N>& xvalue,
+                                           const snarklib::BigInt<N>& yvalue,
+                                           const snarklib::BigInt<N>& qvalue)
+{
+    typedef snarklib::R1Term<FR> R1T;
+    auto& RS = TL<R1C<FR>>::singleton();
+
+    bool isVar = false;
+    for (mp_size_t i = 0; i < N; ++i) {
+        if (x[i].isVariable() || y[i].isVariable())
+            isVar = true;
+    }
+
+    // quotient limbs
+    std::vector<R1T> q;
+    q.reserve(N);
+    for (mp_size_t i = 0; i < N; ++i) {
+        q.emplace_back(
+            RS->createTerm(limbWitness<FR>(qvalue.data()[i]), isVar));
+
+        rangeLimb(q.back(), qvalue.data()[i]);
+    }
+
+    // p = q * y (no overflow)
+    const snarklib::BigInt<N> pvalue = qvalue * yvalue;
+    const std::vector<R1T> p = limbsMUL(q, y, qvalue, yvalue);
+
+    // r = x - p (no borrow)
+    const snarklib::BigInt<N> rvalue = xvalue - pvalue;
+    std::vector<R1T> r;
+    bool borrow;
+    limbsCarry(ScalarOps::SUB, x, p, xvalue, pvalue, r, false, borrow);
+
+    // r < y (borrow out of top limb)
+    std::vector<R1T> d;
+    const R1T lt = limbsCarry(ScalarOps::SUB, r, y, rvalue, yvalue, d, true, borrow);
+#ifdef USE_ASSERT
+    assert(borrow);
+#endif
+    if (lt.isVariable()) RS->setTrue(lt);
+
+    return q;
+}
+
+template <typename FR, mp_size_t N>
+void evalStackOp(std::stack<Alg_BigInt<FR, N>>& S, const ScalarOps op)
+{
+    typedef typename Alg_BigInt<FR, N>::ValueType Value;
+    typedef typename Alg_BigInt<FR, N>::R1T R1T;
+
     // y is right argument
     const auto R = S.top();
     S.pop();
     const Value yvalue = R.value();
-    const FR ywitness = R.witness();
-    const R1T y = RS->argScalar(R);
+    const std::vector<R1T> y = argLimbs(R);
 
     // x is left argument
     const auto L = S.top();
     S.pop();
     const Value xvalue = L.value();
-    const FR xwitness = L.witness();
-    const R1T x = RS->argScalar(L);
+    const std::vector<R1T> x = argLimbs(L);
 
     // z is result
     const Value zvalue = evalOp(op, xvalue, yvalue);
-    const FR zwitness = evalOp(op, xwitness, ywitness);
-    const R1T z = RS->createResult(op, x, y, zwitness);
+    std::vector<R1T> z;
+
+    if (ScalarOps::MUL == op) {
+        z = limbsMUL(x, y, xvalue, yvalue);
+
+    } else if (ScalarOps::DIV == op) {
+        z = limbsDIV(x, y, xvalue, yvalue, zvalue);
+
+    } else {
+        bool carry;
+        limbsCarry(op, x, y, xvalue, yvalue, z, false, carry);
+    }
 
     S.push(
-        Alg_BigInt<FR>(zvalue, zwitness, valueBits(zvalue), {z}));
+        Alg_BigInt<FR, N>(zvalue,
+                          Alg_BigInt<FR, N>::valueToWitness(zvalue),
+                          valueBits(zvalue),
+                          z));
 }
 
-template <typename FR>
-void evalStackCmp(std::stack<Alg_BigInt<FR>>& S, const ScalarCmp op)
+template <typename FR, mp_size_t N>
+void evalStackCmp(std::stack<Alg_BigInt<FR, N>>& S, const ScalarCmp op)
 {
-    typedef typename Alg_BigInt<FR>::ValueType Value;
-    typedef typename Alg_BigInt<FR>::R1T R1T;
+    typedef typename Alg_BigInt<FR, N>::ValueType Value;
+    typedef typename Alg_BigInt<FR, N>::R1T R1T;
     auto& RS = TL<R1C<FR>>::singleton();
-    auto& POW2 = TL<PowersOf2<FR>>::singleton();
 
     // y is right argument
     const auto R = S.top();
     S.pop();
     const Value yvalue = R.value();
-    const FR ywitness = R.witness();
-    const R1T y = RS->argScalar(R);
 
     // x is left argument
     const auto L = S.top();
     S.pop();
     const Value xvalue = L.value();
-    const FR xwitness = L.witness();
-    const R1T x = RS->argScalar(L);
-
-    // for BigInt
-    const mp_size_t N = Value::numberLimbs();
-    const std::size_t N127 = sizeBits(yvalue) - 1;
-    static const Value ovalue = powerBigInt<N>(N127); // half of max value
-
-    // offset is half of maximum value (127 bits)
-    const FR owitness = POW2->getNumber(N127);
-    const R1T o = RS->createConstant(owitness);
-
-    // simpler to handle LT(x, y) as GT(y, x)
-    //               and LE(x, y) as GE(y, x)
-    // which means offset + y - x
-    //  instead of offset + x - y
-    const bool interchangeXY = (ScalarCmp::LT == op || ScalarCmp::LE == op);
-
-    // offset + x (or offset + y)
-    const Value oxvalue = ovalue + (interchangeXY ? yvalue : xvalue);
-    const FR oxwitness = owitness + (interchangeXY ? ywitness : xwitness);
-    const R1T ox = RS->createResult(ScalarOps::ADD,
-                                    o,
-                                    interchangeXY ? y : x,
-                                    oxwitness);
-
-    // offset + x - y (or offset + y - x)
-    const Value oxyvalue = oxvalue - (interchangeXY ? xvalue : yvalue);
-    const FR oxywitness = oxwitness - (interchangeXY ? xwitness : ywitness);
-    const R1T oxy = RS->createResult(ScalarOps::SUB,
-                                     ox,
-                                     interchangeXY ? x : y,
-                                     oxywitness);
-
-    // constraint variable bit representation of offset + x - y (or offset + y - x)
-    const std::vector<int> oxy_splitBits = valueBits(oxyvalue);
-    const std::vector<R1T> oxybits = RS->witnessToBits(oxy, oxy_splitBits);
-    const bool high_witness = oxy_splitBits[N127];
-    const R1T& high_bit = oxybits[N127];
 
     // z is result
     const bool result = evalOp(op, xvalue, yvalue);
     const Value zvalue = powerBigInt<N>(result);
     const FR zwitness = boolTo<FR>(result);
+
+    if (isBits(L) && isBits(R) &&
+        widthBits(L) <= BIGINT_NARROW_BITS &&
+        widthBits(R) <= BIGINT_NARROW_BITS)
+    {
+        S.push(
+            Alg_BigInt<FR, N>(zvalue,
+                              zwitness,
+                              valueBits(zvalue),
+                              {narrowCmp(op, L, R, result)}));
+
+        return;
+    }
+
+    const std::vector<R1T> y = argLimbs(R), x = argLimbs(L);
     R1T z;
 
     switch (op) {
     case (ScalarCmp::EQ) :
-        // if x == y, then offset + x - y == offset == high_bit
-        // so all low bits should be clear and high bit set
-        {
-            std::vector<R1T> bits;
-            bits.reserve(sizeBits(yvalue));
-
-            // all low bits should be clear
-            for (std::size_t i = 0; i < N127; ++i) {
-                bits.emplace_back(oxybits[i]);
-            }
-
-            // complement of high bit should be clear
-            const bool b = evalOp(LogicalOps::CMPLMNT, high_witness, high_witness);
-            bits.emplace_back(
-                RS->createResult(LogicalOps::CMPLMNT,
-                                 high_bit,
-                                 high_bit,
-                                 boolTo<FR>(b)));
-
-            // all bits must be clear
-            z = RS->safeNOR(bits);
-        }
-        break;
-
     case (ScalarCmp::NEQ) :
-        // if x != y, then offset + x - y != offset == high_bit
-        // so some low bit should be set or the high bit clear
+        // EQ: all limbs must be equal
+        // NEQ: some limb must be different
         {
-            std::vector<int> witness;
-            std::vector<R1T> bits;
-            witness.reserve(sizeBits(yvalue));
-            bits.reserve(sizeBits(yvalue));
-
-            // low bits
-            for (std::size_t i = 0; i < N127; ++i) {
-                witness.push_back(oxy_splitBits[i]);
-                bits.emplace_back(oxybits[i]);
+            const bool isEQ = (ScalarCmp::EQ == op);
+            const LogicalOps combine = isEQ ? LogicalOps::AND : LogicalOps::OR;
+
+            bool b = isEQ;
+            for (mp_size_t i = 0; i < N; ++i) {
+                const mp_limb_t
+                    xlimb = xvalue.data()[i],
+                    ylimb = yvalue.data()[i];
+
+                const bool limbResult = isEQ == (xlimb == ylimb);
+                const R1T limbTerm = RS->scalarEquality(op,
+                                                        x[i],
+                                                        y[i],
+                                                        limbWitness<FR>(xlimb) - limbWitness<FR>(ylimb),
+                                                        limbResult);
+
+                if (0 == i) {
+                    b = limbResult;
+                    z = limbTerm;
+                } else {
+                    b = evalOp(combine, b, limbResult);
+                    z = RS->createResult(combine, z, limbTerm, boolTo<FR>(b));
+                }
             }
 
-            // complement of high bit
-            const bool b = evalOp(LogicalOps::CMPLMNT, high_witness, high_witness);
-            witness.push_back(b);
-            bits.emplace_back(
-                RS->createResult(LogicalOps::CMPLMNT,
-                                 high_bit,
-                                 high_bit,
-                                 boolTo<FR>(b)));
-
-            z = RS->safeOR(bits, witness);
+#ifdef USE_ASSERT
+            assert(b == result);
+#endif
         }
         break;
 
-    case (ScalarCmp::LT) : // interchanged X and Y so same as GT
-        // if x < y, then offset + x - y < offset == high_bit
-        // so high bit should be clear and some low bit set
+    case (ScalarCmp::LT) :
+    case (ScalarCmp::GE) :
+        // x < y if and only if x - y borrows from top limb
     case (ScalarCmp::GT) :
-        // if x > y, then offset + x - y > offset == high_bit
-        // so high bit should be set and some low bit should also be set
+    case (ScalarCmp::LE) :
+        // x > y if and only if y - x borrows from top limb
         {
-            std::vector<int> low_witness;
-            std::vector<R1T> low_bits;
-            low_witness.reserve(sizeBits(yvalue));
-            low_bits.reserve(sizeBits(yvalue));
-
-            // low bits
-            for (std::size_t i = 0; i < N127; ++i) {
-                low_witness.push_back(oxy_splitBits[i]);
-                low_bits.emplace_back(oxybits[i]);
-            }
+            const bool interchangeXY = (ScalarCmp::GT == op || ScalarCmp::LE == op);
 
-            // last bit is duplicate to make vector even power of 2
-            low_witness.push_back(low_witness[0]);
-            low_bits.emplace_back(low_bits[0]);
+            std::vector<R1T> d;
+            bool borrowValue;
+            const R1T borrow = interchangeXY
+                ? limbsCarry(ScalarOps::SUB, y, x, yvalue, xvalue, d, true, borrowValue)
+                : limbsCarry(ScalarOps::SUB, x, y, xvalue, yvalue, d, true, borrowValue);
 
-            const R1T low_bit_set = RS->safeOR(low_bits, low_witness);
-            z = RS->createResult(LogicalOps::AND, high_bit, low_bit_set, zwitness);
-        }
-        break;
+            if (ScalarCmp::LT == op || ScalarCmp::GT == op) {
+#ifdef USE_ASSERT
+                assert(borrowValue == result);
+#endif
+                z = borrow;
 
-    case (ScalarCmp::LE) : // interchanged X and Y so same as GE
-        // if x <= y, then offset + x - y <= offset == high_bit
-        // so there are two cases:
-        // some low bit is set and high bit clear (less than)
-        // low bits are clear and high bit is set (equal)
-    case (ScalarCmp::GE) :
-        // if x >= y, then offset + x - y >= offset == high_bit
-        // so high bit should be set (ignore low bits)
-        z = high_bit;
+            } else {
+#ifdef USE_ASSERT
+                assert(borrowValue != result);
+#endif
+                z = RS->createResult(LogicalOps::CMPLMNT, borrow, borrow, zwitness);
+            }
+        }
         break;
     }
 
     S.push(
-        Alg_BigInt<FR>(zvalue, zwitness, valueBits(zvalue), {z}));
+        Alg_BigInt<FR, N>(zvalue, zwitness, valueBits(zvalue), {z}));
 }
 
 } // namespace snarkfront
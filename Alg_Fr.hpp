@@ -0,0 +1,274 @@
+#ifndef _SNARKFRONT_ALG_FR_HPP_
+#define _SNARKFRONT_ALG_FR_HPP_
+
+#include <cassert>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Alg.hpp"
+
+namespace snarkfront {
+
+////////////////////////////////////////////////////////////////////////////////
+// Alg_Fr
+//
+// The application value is the field element itself. There is no
+// integer shadow value and no bit representation, each value is one
+// rank-1 term.
+//
+
+template <typename FR>
+class Alg<FR, FR, ScalarOps, ScalarCmp>
+{
+public:
+    typedef FR ValueType;
+    typedef FR FrType;
+    typedef ScalarOps OpType;
+    typedef ScalarCmp CmpType;
+
+    typedef snarklib::R1Term<FR> R1T;
+    typedef snarklib::R1Variable<FR> R1V;
+
+    Alg() = default;
+
+    // circuit input
+    void bless(const FR& a) {
+        // object is not already initialized
+#ifdef USE_ASSERT
+        assert(m_r1Terms.empty());
+#endif
+
+        m_value = a;
+
+        initTerms(true);
+    }
+
+    // circuit input from demarshalled witness
+    void bless(const R1Cowitness<FR>& input) {
+        bless(valueFromWitness(input));
+    }
+
+    // used by AST_Const and AST_Var constructors
+    Alg(const FR& a, const bool blessed)
+        : m_value(a)
+    {
+        initTerms(blessed);
+    }
+
+    // used by AST_Const and AST_Var constructors from demarshalled witness
+    Alg(const R1Cowitness<FR>& input)
+        : Alg{valueFromWitness(input), true}
+    {}
+
+    // used by operator evaluation
+    Alg(const FR& a,
+        const FR& b,
+        const std::vector<int>& c,
+        const std::vector<R1T>& d)
+        : m_value(a),
+          m_r1Terms(d)
+    {
+#ifdef USE_ASSERT
+        assert(a == b);
+        assert(c.empty());
+        assert(1 == d.size());
+#endif
+    }
+
+    explicit operator bool() const {
+        return FR::zero() != m_value;
+    }
+
+    // application value
+    const FR& value() const {
+        return m_value;
+    }
+
+    // finite field witness is the same
+    const FR& witness() const {
+        return m_value;
+    }
+
+    // never split into bits
+    const std::vector<int>& splitBits() const {
+        return m_splitBits;
+    }
+
+    // return constraint term for scalar
+    const std::vector<R1T>& r1Terms() const {
+        return m_r1Terms;
+    }
+
+    static FR valueToWitness(const FR& a) {
+        return a;
+    }
+
+    // called from AST Variable overloaded assignment operator
+    static Alg
+    assignEval(const AST_Var<Alg>&, const AST_Node<Alg>& rhs) {
+        EvalAST<Alg> E;
+        rhs.accept(E);
+        return E.result();
+    }
+
+    static Alg
+    assignEval(const AST_Var<Alg>& lhs, const FR& rhs) {
+        return assignEval(lhs, AST_Const<Alg>(rhs));
+    }
+
+    // called from AST Foreign node constructor
+    static Alg_bool<FR>
+    compareOp(const ScalarCmp op, const AST_Node<Alg>& a, const AST_Node<Alg>& b)
+    {
+        // evaluate left and right hand side nodes
+        EvalAST<Alg> A, B;
+        a.accept(A);
+        b.accept(B);
+
+        // push left and right hand side results on stack
+        EvalAST<Alg> C;
+        C.push(A.result());
+        C.push(B.result());
+
+        // evaluate comparison operation
+        C.compareOp(op);
+
+        // convert comparison result to predicate
+        const bool result = bool(C.result());
+        return Alg_bool<FR>(result,
+                            boolTo<FR>(result),
+                            valueBits(result),
+                            C.result().r1Terms());
+    }
+
+private:
+    FR valueFromWitness(const R1Cowitness<FR>& input) const {
+        const std::size_t peekID = TL<R1C<FR>>::singleton()->counterID();
+#ifdef USE_ASSERT
+        assert(peekID <= input.sizeSTR());
+#endif
+
+        std::stringstream ss(input[peekID]);
+
+        FR value;
+        ss >> value;
+#ifdef USE_ASSERT
+        assert(!!ss);
+#endif
+
+        return value;
+    }
+
+    void initTerms(const bool blessed) {
+        auto& RS = TL<R1C<FR>>::singleton();
+
+        // one term, may be constant or variable
+        m_r1Terms.emplace_back(
+            RS->createTerm(m_value, blessed));
+
+        if (blessed) {
+            // associate term with variable value
+            RS->witnessTerms(m_r1Terms, m_value);
+        }
+    }
+
+    FR m_value;
+    std::vector<int> m_splitBits; // always empty
+    std::vector<R1T> m_r1Terms;
+};
+
+template <typename FR>
+void evalStackOp(std::stack<Alg_Fr<FR>>& S, const ScalarOps op)
+{
+    typedef typename Alg_Fr<FR>::R1T R1T;
+    auto& RS = TL<R1C<FR>>::singleton();
+
+    // y is right argument
+    const auto R = S.top();
+    S.pop();
+    const FR y_witness = R.witness();
+    const R1T y = R.r1Terms()[0];
+
+    // x is left argument
+    const auto L = S.top();
+    S.pop();
+    const FR x_witness = L.witness();
+    const R1T x = L.r1Terms()[0];
+
+    // division by zero has no witness
+#ifdef USE_ASSERT
+    assert(ScalarOps::DIV != op || FR::zero() != y_witness);
+#endif
+
+    // z is result, one constraint (for DIV, z * y == x)
+    const FR zwitness = evalOp(op, x_witness, y_witness);
+    const R1T z = RS->createResult(op, x, y, zwitness);
+
+    S.push(
+        Alg_Fr<FR>(zwitness, zwitness, std::vector<int>(), {z}));
+}
+
+template <typename FR>
+void evalStackCmp(std::stack<Alg_Fr<FR>>& S, const ScalarCmp op)
+{
+    typedef typename Alg_Fr<FR>::R1T R1T;
+    auto& RS = TL<R1C<FR>>::singleton();
+
+    // field elements are not ordered
+#ifdef USE_ASSERT
+    assert(ScalarCmp::EQ == op || ScalarCmp::NEQ == op);
+#endif
+
+    // y is right argument
+    const auto R = S.top();
+    S.pop();
+    const FR y_witness = R.witness();
+    const R1T y = R.r1Terms()[0];
+
+    // x is left argument
+    const auto L = S.top();
+    S.pop();
+    const FR x_witness = L.witness();
+    const R1T x = L.r1Terms()[0];
+
+    // z is result (evalOp would need ordering for LT, LE, GT, GE)
+    const bool result = (ScalarCmp::EQ == op) == (x_witness == y_witness);
+    const R1T z = RS->scalarEquality(op, x, y, x_witness - y_witness, result);
+
+    S.push(
+        Alg_Fr<FR>(boolTo<FR>(result), boolTo<FR>(result), std::vector<int>(), {z}));
+}
+
+// conditional swap, (x, y) becomes (y, x) if b is true
+template <typename FR>
+void evalSwap(const Alg_bool<FR>& B, Alg_Fr<FR>& X, Alg_Fr<FR>& Y)
+{
+    typedef typename Alg_Fr<FR>::R1T R1T;
+    auto& RS = TL<R1C<FR>>::singleton();
+
+    // b is condition
+    const bool bvalue = B.value();
+#ifdef USE_ASSERT
+    assert(1 == B.r1Terms().size());
+#endif
+    const R1T b = B.r1Terms()[0];
+
+    // x and y are swapped arguments
+    const R1T x = X.r1Terms()[0], y = Y.r1Terms()[0];
+
+    // zx and zy are results, one selector each
+    const FR
+        zxvalue = bvalue ? Y.value() : X.value(),
+        zyvalue = bvalue ? X.value() : Y.value();
+
+    const R1T
+        zx = RS->selectResult(b, x, y, zxvalue),
+        zy = RS->selectResult(b, y, x, zyvalue);
+
+    X = Alg_Fr<FR>(zxvalue, zxvalue, std::vector<int>(), {zx});
+    Y = Alg_Fr<FR>(zyvalue, zyvalue, std::vector<int>(), {zy});
+}
+
+} // namespace snarkfront
+
+#endif
@@ -8,6 +8,7 @@
 namespace snarkfront {
 
 ////////////////////////////////////////////////////////////////////////////////
+// Alg_uint8
 // Alg_uint32
 // Alg_uint64
 //
@@ -55,7 +56,7 @@ void evalStackOp_internal(std::stack<ALG>& S, const BitwiseOps op)
 #endif
 
         } else {
-            x_witness = ALG::valueToString(xvalue);
+            x_witness = ALG::valueToWitness(xvalue);
             const std::vector<R1T> xbits = RS->argBits(L);
             const std::vector<R1T> xfit = rank1_xword(xbits, sizeBits(xvalue));
             x = RS->bitsToWitness(xfit, x_witness);
@@ -84,7 +85,7 @@ void evalStackOp_internal(std::stack<ALG>& S, const BitwiseOps op)
 #endif
 
         } else {
-            y_witness = ALG::valueToString(yvalue);
+            y_witness = ALG::valueToWitness(yvalue);
             const std::vector<R1T> ybits = RS->argBits(R);
             const std::vector<R1T> yfit = rank1_xword(ybits, sizeBits(yvalue));
             y = RS->bitsToWitness(yfit, y_witness);
@@ -118,6 +119,41 @@ void evalStackOp_internal(std::stack<ALG>& S, const BitwiseOps op)
         S.push(
             ALG(zvalue, zwitness, zbits, {z}));
 
+    } else if (BitwiseOps::MULMOD == op) {
+        // x is left argument
+        const auto L = S.top();
+        S.pop();
+        const Value xvalue = L.value();
+
+        // packed words modulo 2^n
+        const Fr
+            x_witness = ALG::valueToWitness(xvalue),
+            y_witness = ALG::valueToWitness(yvalue);
+
+        const R1T
+            x = RS->bitsToWitness(rank1_xword(RS->argBits(L), sizeBits(xvalue)), x_witness),
+            y = RS->bitsToWitness(rank1_xword(RS->argBits(R), sizeBits(yvalue)), y_witness);
+
+        // double width product
+        Value high, low = xvalue;
+        mulover(high, low, yvalue);
+
+        const Value zvalue = BitOps::MULMOD(xvalue, yvalue);
+#ifdef USE_ASSERT
+        assert(zvalue == low);
+#endif
+
+        // split bits of product, low word is the result
+        std::vector<int> zbits = valueBits(low);
+        for (const auto& b : valueBits(high))
+            zbits.push_back(b);
+
+        const Fr zwitness = x_witness * y_witness;
+        const R1T z = RS->createResult(op, x, y, zwitness);
+
+        S.push(
+            ALG(zvalue, zwitness, zbits, {z}));
+
     } else if (BitwiseOps::CMPLMNT == op) {
         // y is only argument
         const std::vector<R1T> y = RS->argBits(R);
@@ -144,7 +180,7 @@ void evalStackOp_internal(std::stack<ALG>& S, const BitwiseOps op)
 #endif
 
         S.push(
-            ALG(zvalue, ALG::valueToString(zvalue), zbits, z));
+            ALG(zvalue, ALG::valueToWitness(zvalue), zbits, z));
 
     } else {
         // x is left argument
@@ -184,10 +220,16 @@ void evalStackOp_internal(std::stack<ALG>& S, const BitwiseOps op)
         }
 
         S.push(
-            ALG(zvalue, ALG::valueToString(zvalue), valueBits(zvalue), z));
+            ALG(zvalue, ALG::valueToWitness(zvalue), valueBits(zvalue), z));
     }
 }
 
+template <typename FR>
+void evalStackOp(std::stack<Alg_uint8<FR>>& S, const BitwiseOps op)
+{
+    evalStackOp_internal<Alg_uint8<FR>, std::uint32_t>(S, op);
+}
+
 template <typename FR>
 void evalStackOp(std::stack<Alg_uint32<FR>>& S, const BitwiseOps op)
 {
@@ -200,8 +242,75 @@ void evalStackOp(std::stack<Alg_uint64<FR>>& S, const BitwiseOps op)
     evalStackOp_internal<Alg_uint64<FR>, std::uint32_t>(S, op);
 }
 
+// conditional swap, (x, y) becomes (y, x) if b is true
+template <typename ALG>
+void evalSwap_internal(const Alg_bool<typename ALG::FrType>& B, ALG& X, ALG& Y)
+{
+    typedef typename ALG::ValueType Value;
+    typedef typename ALG::FrType Fr;
+    typedef typename ALG::R1T R1T;
+    auto& RS = TL<R1C<Fr>>::singleton();
+
+    // b is condition
+    const bool bvalue = B.value();
+#ifdef USE_ASSERT
+    assert(1 == B.r1Terms().size());
+#endif
+    const R1T b = RS->argScalar(B);
+
+    // x and y are swapped arguments
+    const Value xvalue = X.value(), yvalue = Y.value();
+    const std::vector<R1T> x = RS->argBits(X), y = RS->argBits(Y);
+#ifdef USE_ASSERT
+    assert(x.size() >= sizeBits(xvalue));
+    assert(y.size() >= sizeBits(yvalue));
+#endif
+
+    // zx and zy are results
+    const Value
+        zxvalue = bvalue ? yvalue : xvalue,
+        zyvalue = bvalue ? xvalue : yvalue;
+
+    const std::vector<int>
+        zxbits = valueBits(zxvalue),
+        zybits = valueBits(zyvalue);
+
+    // one selector per bit, other bit of pair is also a selector
+    // as x + y - zx is not a single term
+    std::vector<R1T> zx, zy;
+    zx.reserve(sizeBits(zxvalue));
+    zy.reserve(sizeBits(zyvalue));
+    for (std::size_t i = 0; i < sizeBits(zxvalue); ++i) {
+        zx.emplace_back(
+            RS->selectResult(b, x[i], y[i], boolTo<Fr>(zxbits[i])));
+        zy.emplace_back(
+            RS->selectResult(b, y[i], x[i], boolTo<Fr>(zybits[i])));
+    }
+
+    X = ALG(zxvalue, ALG::valueToWitness(zxvalue), zxbits, zx);
+    Y = ALG(zyvalue, ALG::valueToWitness(zyvalue), zybits, zy);
+}
+
+template <typename FR>
+void evalSwap(const Alg_bool<FR>& b, Alg_uint8<FR>& x, Alg_uint8<FR>& y)
+{
+    evalSwap_internal(b, x, y);
+}
+
+template <typename FR>
+void evalSwap(const Alg_bool<FR>& b, Alg_uint32<FR>& x, Alg_uint32<FR>& y)
+{
+    evalSwap_internal(b, x, y);
+}
+
+template <typename FR>
+void evalSwap(const Alg_bool<FR>& b, Alg_uint64<FR>& x, Alg_uint64<FR>& y)
+{
+    evalSwap_internal(b, x, y);
+}
+
 template <typename ALG>
-void evalStackCmp_internal(std::stack<ALG>& S, const EqualityCmp op)
+void evalStackCmp_internal(std::stack<ALG>& S, const ScalarCmp op)
 {
     typedef typename ALG::ValueType Value;
     typedef typename ALG::FrType Fr;
@@ -213,7 +322,6 @@ void evalStackCmp_internal(std::stack<ALG>& S, const EqualityCmp op)
     const auto R = S.top();
     S.pop();
     const Value yvalue = R.value();
-    const std::vector<int> ybits = R.splitBits();
     const std::vector<R1T> y = RS->argBits(R);
 
 #ifdef USE_ASSERT
@@ -224,43 +332,72 @@ void evalStackCmp_internal(std::stack<ALG>& S, const EqualityCmp op)
     const auto L = S.top();
     S.pop();
     const Value xvalue = L.value();
-    const std::vector<int> xbits = L.splitBits();
     const std::vector<R1T> x = RS->argBits(L);
 
 #ifdef USE_ASSERT
     assert(x.size() >= sizeBits(xvalue));
 #endif
 
-    // intermediate constraint variables for each bit
-    std::vector<R1T> zvec;
-    std::vector<int> zwitness;
-    zvec.reserve(sizeBits(yvalue));
-    zwitness.reserve(sizeBits(yvalue));
-    for (std::size_t i = 0; i < sizeBits(yvalue); ++i) {
-        const bool b = evalOp(op, xbits[i], ybits[i]);
-        zwitness.push_back(b);
-        zvec.emplace_back(
-            RS->createResult(eqToLogical(op), x[i], y[i], boolTo<Fr>(b)));
+    // ordering is bit n of 2^n + x - y (one subtraction)
+    if (ScalarCmp::EQ != op && ScalarCmp::NEQ != op) {
+        // GT and LE are GE and LT with x and y interchanged
+        const bool interchangeXY = (ScalarCmp::GT == op || ScalarCmp::LE == op);
+        const Value
+            avalue = interchangeXY ? yvalue : xvalue,
+            bvalue = interchangeXY ? xvalue : yvalue;
+
+        // low bits are a - b modulo 2^n
+        std::vector<int> dbits = valueBits(Value(avalue - bvalue));
+        dbits.push_back(avalue >= bvalue);
+
+        const R1T ge = RS->greaterEqualBits(interchangeXY ? y : x,
+                                            interchangeXY ? x : y,
+                                            dbits);
+
+        // z is result
+        const Value zvalue = evalOp(op, xvalue, yvalue);
+        const R1T z = (ScalarCmp::GE == op || ScalarCmp::LE == op)
+            ? ge
+            : RS->createResult(LogicalOps::CMPLMNT, ge, ge, boolTo<Fr>(zvalue));
+
+        S.push(
+            ALG(zvalue, boolTo<Fr>(zvalue), valueBits(zvalue), {z}));
+
+        return;
     }
 
+    // equality of packed words, difference is invertible if and only
+    // if not equal (AND of all bits SAME is only satisfiable if true)
+    const Fr
+        x_witness = ALG::valueToWitness(xvalue),
+        y_witness = ALG::valueToWitness(yvalue);
+
+    const R1T
+        xw = RS->bitsToWitness(rank1_xword(x, sizeBits(xvalue)), x_witness),
+        yw = RS->bitsToWitness(rank1_xword(y, sizeBits(yvalue)), y_witness);
+
     // z is result
     const Value zvalue = evalOp(op, xvalue, yvalue);
-    const R1T z = EqualityCmp::EQ == op
-        ? RS->safeAND(zvec) // all must be same
-        : RS->safeOR(zvec, zwitness); // one must be different
+    const R1T z = RS->scalarEquality(op, xw, yw, x_witness - y_witness, zvalue);
 
     S.push(
         ALG(zvalue, boolTo<Fr>(zvalue), valueBits(zvalue), {z}));
 }
 
 template <typename FR>
-void evalStackCmp(std::stack<Alg_uint32<FR>>& S, const EqualityCmp op)
+void evalStackCmp(std::stack<Alg_uint8<FR>>& S, const ScalarCmp op)
+{
+    evalStackCmp_internal(S, op);
+}
+
+template <typename FR>
+void evalStackCmp(std::stack<Alg_uint32<FR>>& S, const ScalarCmp op)
 {
     evalStackCmp_internal(S, op);
 }
 
 template <typename FR>
-void evalStackCmp(std::stack<Alg_uint64<FR>>& S, const EqualityCmp op)
+void evalStackCmp(std::stack<Alg_uint64<FR>>& S, const ScalarCmp op)
 {
     evalStackCmp_internal(S, op);
 }
@@ -0,0 +1,275 @@
+#ifndef _SNARKFRONT_BLAKE_2S_HPP_
+#define _SNARKFRONT_BLAKE_2S_HPP_
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Alg.hpp"
+#include "Alg_uint.hpp"
+#include "AST.hpp"
+#include "BitwiseOps.hpp"
+#include "DataBuffer.hpp"
+#include "DSL_base.hpp"
+#include "Lazy.hpp"
+#include "SecureHashStd.hpp"
+#include "SHA_256.hpp"
+
+namespace snarkfront {
+
+////////////////////////////////////////////////////////////////////////////////
+// BLAKE2s message schedule
+//
+
+class BLAKE_2s_SIGMA
+{
+public:
+    // permutations of message words (RFC 7693 section 2.7)
+    static const std::array<std::array<std::uint8_t, 16>, 10>& values() {
+        static const std::array<std::array<std::uint8_t, 16>, 10> a = {{
+            {{  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 }},
+            {{ 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 }},
+            {{ 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 }},
+            {{  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 }},
+            {{  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 }},
+            {{  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 }},
+            {{ 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 }},
+            {{ 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 }},
+            {{  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 }},
+            {{ 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }} }};
+
+        return a;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// BLAKE2s-256 (RFC 7693, no key)
+//
+// The initialization vector is the SHA-256 initial hash value. Rounds
+// use only modulo addition, exclusive-or and rotation.
+//
+
+template <typename T, typename MSG, typename F>
+class BLAKE_2s
+{
+public:
+    typedef T WordType;
+    typedef std::array<T, 16> MsgType;
+    typedef std::array<T, 8> DigType;
+
+    BLAKE_2s()
+        : m_msgBytes(noLength())
+    {}
+
+    // message words are little-endian so the bytes of each word are
+    // reversed (words are read from the stream big-endian), zero bytes
+    // fill the last block (an empty message is one block)
+    static void padMessage(DataBuffer<ClearText>& buf) {
+        const auto a = buf->data();
+        (*buf).clear();
+
+        const std::size_t numBlocks = a.empty() ? 1 : (a.size() + 63) / 64;
+
+        for (std::size_t i = 0; i < 64 * numBlocks; ++i) {
+            const std::size_t j = i - i % 4 + 3 - i % 4;
+            buf.push8(j < a.size() ? a[j] : 0);
+        }
+    }
+
+    static void padMessage(DataBufferStream& buf) {
+        padMessage(*buf);
+    }
+
+    // byte length of message before padding
+    // (default is all message words, no padding)
+    void msgLength(const std::uint64_t numBytes) {
+        m_msgBytes = numBytes;
+    }
+
+    // append (possibly lazy) word to message
+    template <typename U>
+    void msgInput(const U& a) {
+        m_message.emplace_back(a);
+    }
+
+    // append array of words to message
+    template <typename U, std::size_t N>
+    void msgInput(const std::array<U, N>& a) {
+        for (const auto& b : a)
+            msgInput(b);
+    }
+
+    void clearMessage() {
+        m_message.clear();
+        m_msgBytes = noLength();
+    }
+
+    void computeHash() {
+#ifdef USE_ASSERT
+        assert(!m_message.empty() && 0 == m_message.size() % 16);
+#endif
+
+        const std::uint64_t msgBytes =
+            (noLength() == m_msgBytes) ? 4 * m_message.size() : m_msgBytes;
+
+        // parameter block: 32 byte digest, no key, fanout and depth 1
+        const auto IV = SHA_256_H::values();
+        for (std::size_t i = 0; i < 8; ++i) {
+            m_H[i] = F::constant(0 == i ? IV[0] ^ 0x01010020 : IV[i]);
+        }
+
+        const std::size_t numBlocks = m_message.size() / 16;
+        for (std::size_t i = 0; i < numBlocks; ++i) {
+            const bool lastBlock = (numBlocks - 1 == i);
+            compress(16 * i,
+                     lastBlock ? msgBytes : 64 * (i + 1),
+                     lastBlock);
+        }
+    }
+
+    const DigType& digest() const {
+        return m_H;
+    }
+
+private:
+    // message length not set
+    static std::uint64_t noLength() {
+        return -1;
+    }
+
+    // compression function F (RFC 7693 section 3.2)
+    // count is bytes so far including this block
+    void compress(const std::size_t msgIndex,
+                  const std::uint64_t count,
+                  const bool lastBlock)
+    {
+        for (std::size_t i = 0; i < 16; ++i) {
+            m_M[i] = m_message[msgIndex + i];
+        }
+
+        // byte counter and final block flag are constants
+        const auto IV = SHA_256_H::values();
+        for (std::size_t i = 0; i < 8; ++i) {
+            m_v[i] = m_H[i];
+        }
+        m_v[8] = F::constant(IV[0]);
+        m_v[9] = F::constant(IV[1]);
+        m_v[10] = F::constant(IV[2]);
+        m_v[11] = F::constant(IV[3]);
+        m_v[12] = F::constant(IV[4] ^ std::uint32_t(count));
+        m_v[13] = F::constant(IV[5] ^ std::uint32_t(count >> 32));
+        m_v[14] = F::constant(lastBlock ? ~IV[6] : IV[6]);
+        m_v[15] = F::constant(IV[7]);
+
+        for (const auto& s : BLAKE_2s_SIGMA::values()) {
+            G(0, 4,  8, 12, m_M[s[0]], m_M[s[1]]);
+            G(1, 5,  9, 13, m_M[s[2]], m_M[s[3]]);
+            G(2, 6, 10, 14, m_M[s[4]], m_M[s[5]]);
+            G(3, 7, 11, 15, m_M[s[6]], m_M[s[7]]);
+
+            G(0, 5, 10, 15, m_M[s[8]], m_M[s[9]]);
+            G(1, 6, 11, 12, m_M[s[10]], m_M[s[11]]);
+            G(2, 7,  8, 13, m_M[s[12]], m_M[s[13]]);
+            G(3, 4,  9, 14, m_M[s[14]], m_M[s[15]]);
+        }
+
+        for (std::size_t i = 0; i < 8; ++i) {
+            m_H[i] = F::XOR(F::XOR(m_H[i], m_v[i]), m_v[i + 8]);
+        }
+    }
+
+    // mixing function G (RFC 7693 section 3.1)
+    void G(const std::size_t a, const std::size_t b,
+           const std::size_t c, const std::size_t d,
+           const T& x, const T& y)
+    {
+        m_v[a] = F::ADDMOD(F::ADDMOD(m_v[a], m_v[b]), x);
+        m_v[d] = F::ROTR(F::XOR(m_v[d], m_v[a]), 16);
+        m_v[c] = F::ADDMOD(m_v[c], m_v[d]);
+        m_v[b] = F::ROTR(F::XOR(m_v[b], m_v[c]), 12);
+        m_v[a] = F::ADDMOD(F::ADDMOD(m_v[a], m_v[b]), y);
+        m_v[d] = F::ROTR(F::XOR(m_v[d], m_v[a]), 8);
+        m_v[c] = F::ADDMOD(m_v[c], m_v[d]);
+        m_v[b] = F::ROTR(F::XOR(m_v[b], m_v[c]), 7);
+    }
+
+    std::vector<MSG> m_message;
+    std::uint64_t m_msgBytes;
+
+    // message block of 16 32-bit words
+    std::array<T, 16> m_M;
+
+    // working vector of 16 32-bit words
+    std::array<T, 16> m_v;
+
+    // 256-bit hash value
+    std::array<T, 8> m_H;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// convenient message digest for data
+// (the message length is needed for the last block)
+//
+
+template <typename T, typename MSG, typename F>
+typename BLAKE_2s<T, MSG, F>::DigType
+digest(BLAKE_2s<T, MSG, F> hashAlgo, const std::vector<std::uint8_t>& a)
+{
+    DataBufferStream buf(a);
+    hashAlgo.msgLength(a.size());
+    hashAlgo.padMessage(buf);
+    return digest(hashAlgo, buf);
+}
+
+template <typename T, typename MSG, typename F>
+typename BLAKE_2s<T, MSG, F>::DigType
+digest(BLAKE_2s<T, MSG, F> hashAlgo, const std::string& a)
+{
+    DataBufferStream buf(a);
+    hashAlgo.msgLength(a.size());
+    hashAlgo.padMessage(buf);
+    return digest(hashAlgo, buf);
+}
+
+template <typename T, typename MSG, typename F>
+typename BLAKE_2s<T, MSG, F>::DigType
+digest(BLAKE_2s<T, MSG, F> hashAlgo, const char* a)
+{
+    return digest(hashAlgo, std::string(a));
+}
+
+template <typename T, typename MSG, typename F,
+          typename A, typename B, typename... Args>
+typename BLAKE_2s<T, MSG, F>::DigType
+digest(BLAKE_2s<T, MSG, F> hashAlgo,
+       const A& a, const B& b, const Args... parameterPack)
+{
+    DataBufferStream buf;
+    buf.push(a, b, parameterPack...);
+    hashAlgo.msgLength(buf.data().size());
+    hashAlgo.padMessage(buf);
+    return digest(hashAlgo, buf);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// typedefs
+//
+
+namespace zk {
+    template <typename FR> using
+    BLAKE2s = BLAKE_2s<AST_Var<Alg_uint32<FR>>,
+                       Lazy<AST_Var<Alg_uint32<FR>>, std::uint32_t>,
+                       BitwiseAST<Alg_uint32<FR>, Alg_uint32<FR>>>;
+} // namespace zk
+
+namespace eval {
+typedef BLAKE_2s<std::uint32_t,
+                 std::uint32_t,
+                 BitwiseINT<std::uint32_t, std::uint32_t>>
+    BLAKE2s;
+} // namespace eval
+
+} // namespace snarkfront
+
+#endif
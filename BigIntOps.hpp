@@ -95,6 +95,49 @@ snarklib::BigInt<N> operator* (const snarklib::BigInt<N>& a,
     return c;
 }
 
+//
+// a / b --> c (quotient rounded down)
+//
+template <mp_size_t N>
+bool divBigInt(const snarklib::BigInt<N>& a,
+               const snarklib::BigInt<N>& b,
+               snarklib::BigInt<N>& c)
+{
+    // significant limbs of divisor
+    mp_size_t dn = N;
+    while (dn > 0 && 0 == b.data()[dn - 1]) --dn;
+
+    if (0 == dn) return false; // failure if division by zero
+
+    std::array<mp_limb_t, N> remainder;
+    c = snarklib::BigInt<N>::zero();
+    mpn_tdiv_qr(c.data(), remainder.data(), 0, a.data(), N, b.data(), dn);
+    return true;
+}
+
+template <mp_size_t N>
+snarklib::BigInt<N> operator/ (const snarklib::BigInt<N>& a,
+                               const snarklib::BigInt<N>& b)
+{
+    snarklib::BigInt<N> c;
+    if (! divBigInt(a, b, c)) {
+        // division by zero
+#ifdef USE_ASSERT
+        assert(false);
+#endif
+        c = snarklib::BigInt<N>::zero();
+    }
+
+    return c;
+}
+
+template <mp_size_t N>
+snarklib::BigInt<N> divOp(const snarklib::BigInt<N>& a,
+                          const snarklib::BigInt<N>& b)
+{
+    return a / b;
+}
+
 //
 // Russian peasant algorithm
 //
@@ -12,6 +12,7 @@ namespace snarkfront {
 //
 // (T, U) is (uint32_t, uint64_t)
 //        or (uint64_t, uint32_t)
+//        or (uint8_t, uint32_t)
 //
 
 template <typename T, typename U>
@@ -19,46 +20,50 @@ class BitwiseINT
 {
 public:
     // bitwise logical operations
-    static T AND(const T x, const T y) { return x & y; }
-    static T _AND(const T x, const T y) { return AND(x, y); }
-    static T OR(const T x, const T y) { return x | y; }
-    static T _OR(const T x, const T y) { return OR(x, y); }
-    static T XOR(const T x, const T y) { return x ^ y; }
-    static T _XOR(const T x, const T y) { return XOR(x, y); }
-    static T CMPLMNT(const T x) { return ~x; }
-    static T _CMPLMNT(const T x) { return CMPLMNT(x); }
+    static constexpr T AND(const T x, const T y) { return x & y; }
+    static constexpr T _AND(const T x, const T y) { return AND(x, y); }
+    static constexpr T OR(const T x, const T y) { return x | y; }
+    static constexpr T _OR(const T x, const T y) { return OR(x, y); }
+    static constexpr T XOR(const T x, const T y) { return x ^ y; }
+    static constexpr T _XOR(const T x, const T y) { return XOR(x, y); }
+    static constexpr T CMPLMNT(const T x) { return ~x; }
+    static constexpr T _CMPLMNT(const T x) { return CMPLMNT(x); }
 
     // modulo addition
-    static T ADDMOD(const T x, const T y) { return x + y; }
-    static T _ADDMOD(const T x, const T y) { return ADDMOD(x, y); }
+    static constexpr T ADDMOD(const T x, const T y) { return x + y; }
+    static constexpr T _ADDMOD(const T x, const T y) { return ADDMOD(x, y); }
+
+    // modulo multiplication
+    static constexpr T MULMOD(const T x, const T y) { return x * y; }
+    static constexpr T _MULMOD(const T x, const T y) { return MULMOD(x, y); }
 
     // bitwise shift
-    static T SHL(const T x, const unsigned int n) { return x << n; }
-    static T _SHL(const T x, const unsigned int n) { return SHL(x, n); }
-    static T SHR(const T x, const unsigned int n) { return x >> n; }
-    static T _SHR(const T x, const unsigned int n) { return SHR(x, n); }
+    static constexpr T SHL(const T x, const unsigned int n) { return x << n; }
+    static constexpr T _SHL(const T x, const unsigned int n) { return SHL(x, n); }
+    static constexpr T SHR(const T x, const unsigned int n) { return x >> n; }
+    static constexpr T _SHR(const T x, const unsigned int n) { return SHR(x, n); }
 
     // bitwise rotate
-    static T ROTL(const T x, const unsigned int n) {
+    static constexpr T ROTL(const T x, const unsigned int n) {
         return OR(SHL(x, n), SHR(x, sizeof(T) * CHAR_BIT - n));
     }
-    static T _ROTL(const T x, const unsigned int n) {
+    static constexpr T _ROTL(const T x, const unsigned int n) {
         return ROTL(x, n);
     }
-    static T ROTR(const T x, const unsigned int n) {
+    static constexpr T ROTR(const T x, const unsigned int n) {
         return OR(SHR(x, n), SHL(x, sizeof(T) * CHAR_BIT - n));
     }
-    static T _ROTR(const T x, const unsigned int n) {
+    static constexpr T _ROTR(const T x, const unsigned int n) {
         return ROTR(x, n);
     }
 
     // literal value
-    static T constant(const T x) { return x; }
-    static T _constant(const T x) { return constant(x); }
+    static constexpr T constant(const T x) { return x; }
+    static constexpr T _constant(const T x) { return constant(x); }
 
     // converting between 32-bit and 64-bit
-    static U xword(const T x) { return x; }
-    static U _xword(const T x) { return xword(x); }
+    static constexpr U xword(const T x) { return x; }
+    static constexpr U _xword(const T x) { return xword(x); }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -67,6 +72,7 @@ public:
 //
 // (T, U) is (Alg_uint32, Alg_uint64)
 //        or (Alg_uint64, Alg_uint32)
+//        or (Alg_uint8, Alg_uint32)
 //
 
 template <typename T, typename U>
@@ -96,11 +102,12 @@ public:
         return ptrOp(T::OpType:: NAME , x, y);                  \
     }
 
-    // AND, OR, XOR, ADDMOD
+    // AND, OR, XOR, ADDMOD, MULMOD
     DEFN_OPXY(AND)
     DEFN_OPXY(OR)
     DEFN_OPXY(XOR)
     DEFN_OPXY(ADDMOD)
+    DEFN_OPXY(MULMOD)
 
 #undef DEFN_OPXY
 
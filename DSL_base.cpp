@@ -1,3 +1,4 @@
+#include <utility>
 #include "DSL_base.hpp"
 
 using namespace std;
@@ -8,6 +9,10 @@ namespace snarkfront {
 // conditional operator (ternary)
 //
 
+uint8_t ternary(const bool b, const uint8_t x, const uint8_t y) {
+    return b ? x : y;
+}
+
 uint32_t ternary(const bool b, const uint32_t x, const uint32_t y) {
     return b ? x : y;
 }
@@ -16,4 +21,20 @@ uint64_t ternary(const bool b, const uint64_t x, const uint64_t y) {
     return b ? x : y;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// conditional swap
+//
+
+void cswap(const bool b, uint8_t& x, uint8_t& y) {
+    if (b) swap(x, y);
+}
+
+void cswap(const bool b, uint32_t& x, uint32_t& y) {
+    if (b) swap(x, y);
+}
+
+void cswap(const bool b, uint64_t& x, uint64_t& y) {
+    if (b) swap(x, y);
+}
+
 } // namespace snarkfront
@@ -2,11 +2,16 @@
 #define _SNARKFRONT_DSL_BASE_HPP_
 
 #include <array>
+#include <cassert>
 #include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "Alg.hpp"
 #include "Alg_BigInt.hpp"
 #include "Alg_bool.hpp"
+#include "Alg_Fr.hpp"
 #include "Alg_uint.hpp"
 #include "DataBuffer.hpp"
 #include "PowersOf2.hpp"
@@ -19,16 +24,28 @@ namespace snarkfront {
 
 // constants
 template <typename FR> using c_bool = AST_Const<Alg_bool<FR>>;
-template <typename FR> using c_bigint = AST_Const<Alg_BigInt<FR>>;
+template <typename FR, mp_size_t N = 2> using c_bigint = AST_Const<Alg_BigInt<FR, N>>;
+template <typename FR> using c_fr = AST_Const<Alg_Fr<FR>>;
+template <typename FR> using c_uint8 = AST_Const<Alg_uint8<FR>>;
 template <typename FR> using c_uint32 = AST_Const<Alg_uint32<FR>>;
 template <typename FR> using c_uint64 = AST_Const<Alg_uint64<FR>>;
 
 // variables
 template <typename FR> using bool_x = AST_Var<Alg_bool<FR>>;
-template <typename FR> using bigint_x = AST_Var<Alg_BigInt<FR>>;
+template <typename FR, mp_size_t N = 2> using bigint_x = AST_Var<Alg_BigInt<FR, N>>;
+template <typename FR> using fr_x = AST_Var<Alg_Fr<FR>>;
+template <typename FR> using uint8_x = AST_Var<Alg_uint8<FR>>;
 template <typename FR> using uint32_x = AST_Var<Alg_uint32<FR>>;
 template <typename FR> using uint64_x = AST_Var<Alg_uint64<FR>>;
 
+// big integers of fixed width (64-bit limbs on x86-64)
+template <typename FR> using c_bigint64 = c_bigint<FR, 1>;
+template <typename FR> using c_bigint128 = c_bigint<FR, 2>;
+template <typename FR> using c_bigint256 = c_bigint<FR, 4>;
+template <typename FR> using bigint64_x = bigint_x<FR, 1>;
+template <typename FR> using bigint128_x = bigint_x<FR, 2>;
+template <typename FR> using bigint256_x = bigint_x<FR, 4>;
+
 ////////////////////////////////////////////////////////////////////////////////
 // convenient message digest for data
 // (new variables for entire message block)
@@ -81,6 +98,98 @@ typename T::DigType digest(T hashAlgo, const Args... parameterPack)
     return digest(hashAlgo, buf);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// message digest with padding and public words as constants
+// (new variables only for private message words)
+//
+
+// publicWords[i] is true if word i of the padded message is public,
+// words after the message (padding and length) are always constant
+template <typename T>
+typename T::DigType digest_const(T hashAlgo,
+                                 const DataBufferStream& msg,
+                                 const std::vector<bool>& publicWords = std::vector<bool>())
+{
+    typedef typename T::ValueType Value;
+
+    auto buf = msg;
+    const std::size_t msgWords = (buf.data().size() + sizeof(Value) - 1) / sizeof(Value);
+    T::padMessage(buf);
+
+    for (std::size_t i = 0; ! buf.empty(); ++i) {
+        if (i >= msgWords || (i < publicWords.size() && publicWords[i])) {
+            hashAlgo.msgConstant(buf.getWord<Value>());
+        } else {
+            typename T::WordType w;
+            bless(w, buf);
+            hashAlgo.msgInput(w);
+        }
+    }
+
+    hashAlgo.computeHash();
+
+    return hashAlgo.digest();
+}
+
+template <typename T>
+typename T::DigType digest_const(T hashAlgo,
+                                 const std::string& a,
+                                 const std::vector<bool>& publicWords = std::vector<bool>())
+{
+    return digest_const(hashAlgo, DataBufferStream(a), publicWords);
+}
+
+template <typename T>
+typename T::DigType digest_const(T hashAlgo,
+                                 const std::vector<std::uint8_t>& a,
+                                 const std::vector<bool>& publicWords = std::vector<bool>())
+{
+    return digest_const(hashAlgo, DataBufferStream(a), publicWords);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// message digest with public prefix blocks compressed natively
+// (only the suffix blocks become constraints)
+//
+
+// intermediate hash value after prefix of whole message blocks
+// (eval hash algorithm)
+template <typename T>
+typename T::MidType midstate(T hashAlgo, const DataBufferStream& prefix)
+{
+    auto bufCopy = prefix; // need copy as streaming consumes it
+
+#ifdef USE_ASSERT
+    assert(! T::padNeeded(bufCopy));
+#endif
+
+    hashAlgo.update(bufCopy);
+    return hashAlgo.hashValue();
+}
+
+// message digest of suffix data starting from midstate of prefix
+// (adds padding, message length includes the prefix)
+template <typename T, typename U, std::size_t N>
+typename T::DigType digest_midstate(T hashAlgo,
+                                    const std::array<U, N>& mid,
+                                    const std::size_t prefixBytes,
+                                    const DataBufferStream& suffix)
+{
+    auto buf = suffix;
+    T::padMessage(buf, 8 * prefixBytes);
+    hashAlgo.setMidstate(mid);
+    return digest(hashAlgo, buf);
+}
+
+template <typename T, typename U, std::size_t N>
+typename T::DigType digest_midstate(T hashAlgo,
+                                    const std::array<U, N>& mid,
+                                    const std::size_t prefixBytes,
+                                    const std::string& suffix)
+{
+    return digest_midstate(hashAlgo, mid, prefixBytes, DataBufferStream(suffix));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // logical and bitwise complement
 //
@@ -96,13 +205,14 @@ typename T::DigType digest(T hashAlgo, const Args... parameterPack)
     }
 
     DEFN_CMPLMNT(bool, !)
+    DEFN_CMPLMNT(uint8, ~)
     DEFN_CMPLMNT(uint32, ~)
     DEFN_CMPLMNT(uint64, ~)
 
 #undef DEFN_CMPLMNT
 
 ////////////////////////////////////////////////////////////////////////////////
-// AND, OR, XOR, ADD, SUB, MUL, ADDMOD
+// AND, OR, XOR, ADD, SUB, MUL, DIV, ADDMOD, MULMOD
 //
 
 #define DEFN_OP(ALG, OP, ENUM)                                          \
@@ -138,25 +248,82 @@ typename T::DigType digest(T hashAlgo, const Args... parameterPack)
     }
 
     DEFN_OP(bool, &&, AND)
+    DEFN_OP(uint8, &, AND)
     DEFN_OP(uint32, &, AND)
     DEFN_OP(uint64, &, AND)
 
     DEFN_OP(bool, ||, OR)
+    DEFN_OP(uint8, |, OR)
     DEFN_OP(uint32, |, OR)
     DEFN_OP(uint64, |, OR)
 
+    DEFN_OP(uint8, ^, XOR)
     DEFN_OP(uint32, ^, XOR)
     DEFN_OP(uint64, ^, XOR)
 
-    DEFN_OP(BigInt, +, ADD)
-    DEFN_OP(BigInt, -, SUB)
-    DEFN_OP(BigInt, *, MUL)
+#define DEFN_OP_BIGINT(OP, ENUM)                                        \
+    template <typename FR, mp_size_t N>                                 \
+    AST_Op<Alg_BigInt<FR, N>>                                           \
+    operator OP(                                                        \
+        const AST_Node<Alg_BigInt<FR, N>>& x,                           \
+        const AST_Node<Alg_BigInt<FR, N>>& y)                           \
+    {                                                                   \
+        return AST_Op<Alg_BigInt<FR, N>>(ScalarOps:: ENUM,              \
+                                         x,                             \
+                                         y);                            \
+    }                                                                   \
+    template <typename FR, mp_size_t N>                                 \
+    AST_Op<Alg_BigInt<FR, N>>                                           \
+    operator OP(                                                        \
+        const AST_Node<Alg_BigInt<FR, N>>& x,                           \
+        const typename Alg_BigInt<FR, N>::ValueType& y)                 \
+    {                                                                   \
+        return AST_Op<Alg_BigInt<FR, N>>(ScalarOps:: ENUM,              \
+                                         x,                             \
+                                         new AST_Const<Alg_BigInt<FR, N>>(y)); \
+    }                                                                   \
+    template <typename FR, mp_size_t N>                                 \
+    AST_Op<Alg_BigInt<FR, N>>                                           \
+    operator OP(                                                        \
+        const typename Alg_BigInt<FR, N>::ValueType& x,                 \
+        const AST_Node<Alg_BigInt<FR, N>>& y)                           \
+    {                                                                   \
+        return AST_Op<Alg_BigInt<FR, N>>(ScalarOps:: ENUM,              \
+                                         new AST_Const<Alg_BigInt<FR, N>>(x), \
+                                         y);                            \
+    }
+
+    DEFN_OP_BIGINT(+, ADD)
+    DEFN_OP_BIGINT(-, SUB)
+    DEFN_OP_BIGINT(*, MUL)
+    DEFN_OP_BIGINT(/, DIV)
 
+#undef DEFN_OP_BIGINT
+
+    DEFN_OP(Fr, +, ADD)
+    DEFN_OP(Fr, -, SUB)
+    DEFN_OP(Fr, *, MUL)
+    DEFN_OP(Fr, /, DIV)
+
+    DEFN_OP(uint8, +, ADDMOD)
     DEFN_OP(uint32, +, ADDMOD)
     DEFN_OP(uint64, +, ADDMOD)
 
+    DEFN_OP(uint8, *, MULMOD)
+    DEFN_OP(uint32, *, MULMOD)
+    DEFN_OP(uint64, *, MULMOD)
+
 #undef DEFN_OP
 
+// field inverse is 1 / x (one constraint, x must not be zero)
+template <typename FR>
+AST_Op<Alg_Fr<FR>> INV(const AST_Node<Alg_Fr<FR>>& x)
+{
+    return AST_Op<Alg_Fr<FR>>(ScalarOps::DIV,
+                              new AST_Const<Alg_Fr<FR>>(FR::one()),
+                              x);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // bitwise shift and rotate
 //
@@ -173,15 +340,19 @@ typename T::DigType digest(T hashAlgo, const Args... parameterPack)
                                        new AST_Const<Alg_ ## ALG<FR>>(n)); \
     }
 
+    DEFN_PERMUTE(uint8, operator<<, SHL)
     DEFN_PERMUTE(uint32, operator<<, SHL)
     DEFN_PERMUTE(uint64, operator<<, SHL)
 
+    DEFN_PERMUTE(uint8, operator>>, SHR)
     DEFN_PERMUTE(uint32, operator>>, SHR)
     DEFN_PERMUTE(uint64, operator>>, SHR)
 
+    DEFN_PERMUTE(uint8, ROTL, ROTL)
     DEFN_PERMUTE(uint32, ROTL, ROTL)
     DEFN_PERMUTE(uint64, ROTL, ROTL)
 
+    DEFN_PERMUTE(uint8, ROTR, ROTR)
     DEFN_PERMUTE(uint32, ROTR, ROTR)
     DEFN_PERMUTE(uint64, ROTR, ROTR)
 
@@ -226,18 +397,70 @@ typename T::DigType digest(T hashAlgo, const Args... parameterPack)
     DEFN_CMP(bool, ==, EQ)
     DEFN_CMP(bool, !=, NEQ)
 
-    DEFN_CMP(BigInt, ==, EQ)
-    DEFN_CMP(BigInt, !=, EQ)
-    DEFN_CMP(BigInt, <, LT)
-    DEFN_CMP(BigInt, <=, LE)
-    DEFN_CMP(BigInt, >, GT)
-    DEFN_CMP(BigInt, >=, GE)
+#define DEFN_CMP_BIGINT(OP, ENUM)                                       \
+    template <typename FR, mp_size_t N>                                 \
+    AST_X<Alg_bool<FR>>                                                 \
+    operator OP(                                                        \
+        const AST_Node<Alg_BigInt<FR, N>>& x,                           \
+        const AST_Node<Alg_BigInt<FR, N>>& y)                           \
+    {                                                                   \
+        return AST_X<Alg_bool<FR>>(ScalarCmp:: ENUM,                    \
+                                   x,                                   \
+                                   y);                                  \
+    }                                                                   \
+    template <typename FR, mp_size_t N>                                 \
+    AST_X<Alg_bool<FR>>                                                 \
+    operator OP(                                                        \
+        const AST_Node<Alg_BigInt<FR, N>>& x,                           \
+        const typename Alg_BigInt<FR, N>::ValueType& y)                 \
+    {                                                                   \
+        return AST_X<Alg_bool<FR>>(ScalarCmp:: ENUM,                    \
+                                   x,                                   \
+                                   y);                                  \
+    }                                                                   \
+    template <typename FR, mp_size_t N>                                 \
+    AST_X<Alg_bool<FR>>                                                 \
+    operator OP(                                                        \
+        const typename Alg_BigInt<FR, N>::ValueType& x,                 \
+        const AST_Node<Alg_BigInt<FR, N>>& y)                           \
+    {                                                                   \
+        return AST_X<Alg_bool<FR>>(ScalarCmp:: ENUM,                    \
+                                   x,                                   \
+                                   y);                                  \
+    }
+
+    DEFN_CMP_BIGINT(==, EQ)
+    DEFN_CMP_BIGINT(!=, NEQ)
+    DEFN_CMP_BIGINT(<, LT)
+    DEFN_CMP_BIGINT(<=, LE)
+    DEFN_CMP_BIGINT(>, GT)
+    DEFN_CMP_BIGINT(>=, GE)
+
+#undef DEFN_CMP_BIGINT
+
+    DEFN_CMP(Fr, ==, EQ)
+    DEFN_CMP(Fr, !=, NEQ)
+
+    DEFN_CMP(uint8, ==, EQ)
+    DEFN_CMP(uint8, !=, NEQ)
+    DEFN_CMP(uint8, <, LT)
+    DEFN_CMP(uint8, <=, LE)
+    DEFN_CMP(uint8, >, GT)
+    DEFN_CMP(uint8, >=, GE)
 
     DEFN_CMP(uint32, ==, EQ)
-    DEFN_CMP(uint32, !=, EQ)
+    DEFN_CMP(uint32, !=, NEQ)
+    DEFN_CMP(uint32, <, LT)
+    DEFN_CMP(uint32, <=, LE)
+    DEFN_CMP(uint32, >, GT)
+    DEFN_CMP(uint32, >=, GE)
 
     DEFN_CMP(uint64, ==, EQ)
-    DEFN_CMP(uint64, !=, EQ)
+    DEFN_CMP(uint64, !=, NEQ)
+    DEFN_CMP(uint64, <, LT)
+    DEFN_CMP(uint64, <=, LE)
+    DEFN_CMP(uint64, >, GT)
+    DEFN_CMP(uint64, >=, GE)
 
 #undef DEFN_CMP
 
@@ -291,7 +514,7 @@ public:
         }
 
         return
-            ArrayCmp<FR, T, U, N-1>::notEqual(xslice, yslice) &&
+            ArrayCmp<FR, T, U, N-1>::notEqual(xslice, yslice) ||
             x[N-1] != y[N-1];
     }
 };
@@ -308,6 +531,14 @@ AST_X<Alg_bool<FR>> operator!= (const std::array< T , N>& x,    \
     return ArrayCmp<FR, T , U , N>::notEqual(x, y);             \
 }
 
+DEFN_CMP_ARRAY(fr_x<FR>, fr_x<FR>)
+DEFN_CMP_ARRAY(fr_x<FR>, FR)
+DEFN_CMP_ARRAY(FR, fr_x<FR>)
+
+DEFN_CMP_ARRAY(uint8_x<FR>, uint8_x<FR>)
+DEFN_CMP_ARRAY(uint8_x<FR>, std::uint8_t)
+DEFN_CMP_ARRAY(std::uint8_t, uint8_x<FR>)
+
 DEFN_CMP_ARRAY(uint32_x<FR>, uint32_x<FR>)
 DEFN_CMP_ARRAY(uint32_x<FR>, std::uint32_t)
 DEFN_CMP_ARRAY(std::uint32_t, uint32_x<FR>)
@@ -319,7 +550,7 @@ DEFN_CMP_ARRAY(std::uint64_t, uint64_x<FR>)
 #undef DEFN_CMP_ARRAY
 
 ////////////////////////////////////////////////////////////////////////////////
-// convert to and between 32-bit and 64-bit words
+// convert to and between 8-bit, 32-bit and 64-bit words
 //
 
 template <typename FR>
@@ -332,6 +563,37 @@ AST_X<Alg_uint64<FR>> xword(const AST_Node<Alg_uint32<FR>>& x) {
     return AST_X<Alg_uint64<FR>>(x);
 }
 
+// bytes widen to and truncate from the word type of the dummy argument
+template <typename FR>
+AST_X<Alg_uint32<FR>> xword(const AST_Node<Alg_uint8<FR>>& x,
+                            const AST_Node<Alg_uint32<FR>>& dummy) {
+    return AST_X<Alg_uint32<FR>>(x);
+}
+
+template <typename FR>
+AST_X<Alg_uint64<FR>> xword(const AST_Node<Alg_uint8<FR>>& x,
+                            const AST_Node<Alg_uint64<FR>>& dummy) {
+    return AST_X<Alg_uint64<FR>>(x);
+}
+
+template <typename FR>
+AST_X<Alg_uint8<FR>> xword(const AST_Node<Alg_uint32<FR>>& x,
+                           const AST_Node<Alg_uint8<FR>>& dummy) {
+    return AST_X<Alg_uint8<FR>>(x);
+}
+
+template <typename FR>
+AST_X<Alg_uint8<FR>> xword(const AST_Node<Alg_uint64<FR>>& x,
+                           const AST_Node<Alg_uint8<FR>>& dummy) {
+    return AST_X<Alg_uint8<FR>>(x);
+}
+
+template <typename FR>
+AST_X<Alg_uint8<FR>> xword(const AST_Node<Alg_bool<FR>>& x,
+                           const AST_Node<Alg_uint8<FR>>& dummy) {
+    return AST_X<Alg_uint8<FR>>(x);
+}
+
 template <typename FR>
 AST_X<Alg_uint32<FR>> xword(const AST_Node<Alg_bool<FR>>& x,
                             const AST_Node<Alg_uint32<FR>>& dummy) {
@@ -348,6 +610,31 @@ AST_X<Alg_uint64<FR>> xword(const AST_Node<Alg_bool<FR>>& x,
 // conditional operator (ternary)
 //
 
+template <typename FR>
+AST_Op<Alg_uint8<FR>> ternary(const AST_Node<Alg_bool<FR>>& b,
+                              const AST_Node<Alg_uint8<FR>>& x,
+                              const AST_Node<Alg_uint8<FR>>& y)
+{
+    return
+        // (x & xword(b)) | (y & ~xword(b))
+        AST_Op<Alg_uint8<FR>>(
+            Alg_uint8<FR>::OpType::OR,
+
+            // x & xword(b)
+            new AST_Op<Alg_uint8<FR>>(
+                Alg_uint8<FR>::OpType::AND,
+                x,
+                new AST_X<Alg_uint8<FR>>(b)),
+
+            // y & ~xword(b)
+            new AST_Op<Alg_uint8<FR>>(
+                Alg_uint8<FR>::OpType::AND,
+                y,
+                new AST_Op<Alg_uint8<FR>>(
+                    Alg_uint8<FR>::OpType::CMPLMNT,
+                    new AST_X<Alg_uint8<FR>>(b))));
+}
+
 template <typename FR>
 AST_Op<Alg_uint32<FR>> ternary(const AST_Node<Alg_bool<FR>>& b,
                                const AST_Node<Alg_uint32<FR>>& x,
@@ -398,6 +685,21 @@ AST_Op<Alg_uint64<FR>> ternary(const AST_Node<Alg_bool<FR>>& b,
                     new AST_X<Alg_uint64<FR>>(b))));
 }
 
+template <typename FR, std::size_t N>
+std::array<AST_Var<Alg_uint8<FR>>, N>
+ternary(const AST_Node<Alg_bool<FR>>& b,
+        const std::array<AST_Var<Alg_uint8<FR>>, N>& x,
+        const std::array<AST_Var<Alg_uint8<FR>>, N>& y)
+{
+    std::array<AST_Var<Alg_uint8<FR>>, N> result;
+
+    for (std::size_t i = 0; i < N; ++i) {
+        result[i] = ternary(b, x[i], y[i]);
+    }
+
+    return result;
+}
+
 template <typename FR, std::size_t N>
 std::array<AST_Var<Alg_uint32<FR>>, N>
 ternary(const AST_Node<Alg_bool<FR>>& b,
@@ -428,6 +730,10 @@ ternary(const AST_Node<Alg_bool<FR>>& b,
     return result;
 }
 
+std::uint8_t ternary(const bool b,
+                     const std::uint8_t x,
+                     const std::uint8_t y);
+
 std::uint32_t ternary(const bool b,
                       const std::uint32_t x,
                       const std::uint32_t y);
@@ -436,6 +742,20 @@ std::uint64_t ternary(const bool b,
                       const std::uint64_t x,
                       const std::uint64_t y);
 
+template <std::size_t N>
+std::array<std::uint8_t, N> ternary(const bool b,
+                                    const std::array<std::uint8_t, N>& x,
+                                    const std::array<std::uint8_t, N>& y)
+{
+    std::array<std::uint8_t, N> result;
+
+    for (std::size_t i = 0; i < N; ++i) {
+        result[i] = ternary(b, x[i], y[i]);
+    }
+
+    return result;
+}
+
 template <std::size_t N>
 std::array<std::uint32_t, N> ternary(const bool b,
                                      const std::array<std::uint32_t, N>& x,
@@ -464,6 +784,84 @@ std::array<std::uint64_t, N> ternary(const bool b,
     return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// conditional swap
+// (x, y) becomes (y, x) if b is true
+//
+
+#define DEFN_CSWAP(ALG)                                                 \
+    template <typename FR>                                              \
+    void cswap(const AST_Node<Alg_bool<FR>>& b,                         \
+               AST_Var<Alg_ ## ALG<FR>>& x,                             \
+               AST_Var<Alg_ ## ALG<FR>>& y)                             \
+    {                                                                   \
+        EvalAST<Alg_bool<FR>> E;                                        \
+        b.accept(E);                                                    \
+                                                                        \
+        auto X = *x, Y = *y;                                            \
+        evalSwap(E.result(), X, Y);                                     \
+                                                                        \
+        x.bless(X.value(), X.witness(), X.splitBits(), X.r1Terms());    \
+        y.bless(Y.value(), Y.witness(), Y.splitBits(), Y.r1Terms());    \
+    }                                                                   \
+    template <typename FR, std::size_t N>                               \
+    void cswap(const AST_Node<Alg_bool<FR>>& b,                         \
+               std::array<AST_Var<Alg_ ## ALG<FR>>, N>& x,              \
+               std::array<AST_Var<Alg_ ## ALG<FR>>, N>& y)              \
+    {                                                                   \
+        EvalAST<Alg_bool<FR>> E;                                        \
+        b.accept(E);                                                    \
+                                                                        \
+        for (std::size_t i = 0; i < N; ++i) {                           \
+            auto X = *x[i], Y = *y[i];                                  \
+            evalSwap(E.result(), X, Y);                                 \
+                                                                        \
+            x[i].bless(X.value(), X.witness(), X.splitBits(), X.r1Terms()); \
+            y[i].bless(Y.value(), Y.witness(), Y.splitBits(), Y.r1Terms()); \
+        }                                                               \
+    }
+
+    DEFN_CSWAP(Fr)
+    DEFN_CSWAP(uint8)
+    DEFN_CSWAP(uint32)
+    DEFN_CSWAP(uint64)
+
+#undef DEFN_CSWAP
+
+void cswap(const bool b, std::uint8_t& x, std::uint8_t& y);
+void cswap(const bool b, std::uint32_t& x, std::uint32_t& y);
+void cswap(const bool b, std::uint64_t& x, std::uint64_t& y);
+
+// field elements (eval), only types with a static one() so that zk
+// variables do not swap without constraints
+template <typename FR>
+typename std::enable_if<std::is_same<decltype(FR::one()), FR>::value>::type
+cswap(const bool b, FR& x, FR& y)
+{
+    if (b) std::swap(x, y);
+}
+
+template <typename T, std::size_t N>
+void cswap(const bool b, std::array<T, N>& x, std::array<T, N>& y)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        cswap(b, x[i], y[i]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// range check, comparisons of big integers decompose only width + 1 bits
+//
+
+template <typename FR, mp_size_t N>
+void assert_range(AST_Var<Alg_BigInt<FR, N>>& x, const std::size_t width)
+{
+    auto X = *x;
+    evalRange(X, width);
+
+    x.bless(X.value(), X.witness(), X.splitBits(), X.r1Terms());
+}
+
 } // namespace snarkfront
 
 #endif
@@ -10,7 +10,6 @@
 #include "DSL_utility.hpp"
 #include "PowersOf2.hpp"
 #include "R1C.hpp"
-#include <sstream>
 #include "TLsingleton.hpp"
 
 namespace snarkfront {
@@ -21,19 +20,32 @@ namespace snarkfront {
 
 // variable with value
 template <typename FR> void bless(bool_x<FR>& x, const bool a) { x.bless(a); }
-template <typename FR> void bless(bigint_x<FR>& x, const std::string& a) { x.bless(a); }
+template <typename FR, mp_size_t N> void bless(bigint_x<FR, N>& x, const std::string& a) { x.bless(a); }
+template <typename FR> void bless(fr_x<FR>& x, const FR& a) { x.bless(a); }
+template <typename FR> void bless(uint8_x<FR>& x, const std::uint8_t a) { x.bless(a); }
 template <typename FR> void bless(uint32_x<FR>& x, const std::uint32_t a) { x.bless(a); }
 template <typename FR> void bless(uint64_x<FR>& x, const std::uint64_t a) { x.bless(a); }
 
-template <typename FR> void bless(bigint_x<FR>& x, const std::uint64_t a) {
-    std::stringstream ss;
-    ss << a;
-    x.bless(ss.str());
+template <typename FR, mp_size_t N> void bless(bigint_x<FR, N>& x, const std::uint64_t a) {
+    x.bless(typename Alg_BigInt<FR, N>::ValueType(a));
+}
+
+// variable with value of declared width (range checked)
+template <typename FR, mp_size_t N>
+void bless(bigint_x<FR, N>& x, const std::uint64_t a, const std::size_t width) {
+    bless(x, a);
+    assert_range(x, width);
+}
+
+template <typename FR> void bless(fr_x<FR>& x, const std::uint64_t a) {
+    x.bless(TL<PowersOf2<FR>>::singleton()->getNumber(a));
 }
 
 // initialize variable
 template <typename FR> void bless(bool_x<FR>& x) { bless(x, false); }
-template <typename FR> void bless(bigint_x<FR>& x) { bless(x, "0"); }
+template <typename FR, mp_size_t N> void bless(bigint_x<FR, N>& x) { bless(x, "0"); }
+template <typename FR> void bless(fr_x<FR>& x) { bless(x, FR::zero()); }
+template <typename FR> void bless(uint8_x<FR>& x) { bless(x, 0); }
 template <typename FR> void bless(uint32_x<FR>& x) { bless(x, 0); }
 template <typename FR> void bless(uint64_x<FR>& x) { bless(x, 0); }
 
@@ -68,8 +80,10 @@ void bless(std::array<T, N>& x, const U& a)
 
     typedef typename T::FrType FR;
 
+    // a range checked big integer has fewer bits, high bits are zero
     const auto term_bits = TL<R1C<FR>>::singleton()->argBits(*a);
-    const auto split_bits = a->splitBits();
+    auto split_bits = a->splitBits();
+    split_bits.resize(sizeU, 0);
 
     for (std::size_t i = 0; i < N; ++i) {
         const std::vector<typename T::R1T> term_vec(
@@ -103,6 +117,12 @@ void bless(std::array<T, N>& a, const R1Cowitness<FR>& input) {
         bless(x, input);
 }
 
+// 8-bit byte variable from data buffer stream
+template <typename FR>
+void bless(uint8_x<FR>& x, DataBufferStream& ss) {
+    bless(x, ss.getWord<std::uint8_t>());
+}
+
 // 32-bit word variable from data buffer stream
 template <typename FR>
 void bless(uint32_x<FR>& x, DataBufferStream& ss) {
@@ -115,6 +135,9 @@ void bless(uint64_x<FR>& x, DataBufferStream& ss) {
     bless(x, ss.getWord<std::uint64_t>());
 }
 
+// 8-bit value from data buffer stream (useful for templates)
+void bless(std::uint8_t& a, DataBufferStream& ss);
+
 // 32-bit value from data buffer stream (useful for templates)
 void bless(std::uint32_t& a, DataBufferStream& ss);
 
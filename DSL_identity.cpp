@@ -17,6 +17,15 @@ bool one(const bool& dummy) {
     return true;
 }
 
+// 8-bit byte
+uint8_t zero(const uint8_t& dummy) {
+    return 0;
+}
+
+uint8_t one(const uint8_t& dummy) {
+    return 1;
+}
+
 // 32-bit word
 uint32_t zero(const uint32_t& dummy) {
     return 0;
@@ -47,19 +47,64 @@ snarklib::BigInt<N> one(const snarklib::BigInt<N>& dummy) {
     return snarklib::BigInt<N>::one();
 }
 
+template <typename FR, mp_size_t L>
+c_bigint<FR, L> zero(const bigint_x<FR, L>& dummy) {
+    return c_bigint<FR, L>(bigint_x<FR, L>::ValueType::zero());
+}
+
+template <typename FR, mp_size_t L>
+c_bigint<FR, L> one(const bigint_x<FR, L>& dummy) {
+    return c_bigint<FR, L>(bigint_x<FR, L>::ValueType::one());
+}
+
+template <typename FR, mp_size_t L, std::size_t N>
+std::array<c_bigint<FR, L>, N> zero(const std::array<bigint_x<FR, L>, N>& dummy) {
+    std::array<c_bigint<FR, L>, N> a;
+
+    for (std::size_t i = 0; i < N; ++i)
+        a[i] = zero(dummy[i]);
+
+    return a;
+}
+
+// field scalar
+template <typename FR>
+c_fr<FR> zero(const fr_x<FR>& dummy) {
+    return c_fr<FR>(FR::zero());
+}
+
+template <typename FR>
+c_fr<FR> one(const fr_x<FR>& dummy) {
+    return c_fr<FR>(FR::one());
+}
+
+template <typename FR, std::size_t N>
+std::array<c_fr<FR>, N> zero(const std::array<fr_x<FR>, N>& dummy) {
+    std::array<c_fr<FR>, N> a;
+
+    for (std::size_t i = 0; i < N; ++i)
+        a[i] = zero(dummy[i]);
+
+    return a;
+}
+
+// 8-bit byte
+std::uint8_t zero(const std::uint8_t& dummy);
+std::uint8_t one(const std::uint8_t& dummy);
+
 template <typename FR>
-c_bigint<FR> zero(const bigint_x<FR>& dummy) {
-    return c_bigint<FR>(bigint_x<FR>::ValueType::zero());
+c_uint8<FR> zero(const uint8_x<FR>& dummy) {
+    return c_uint8<FR>(0);
 }
 
 template <typename FR>
-c_bigint<FR> one(const bigint_x<FR>& dummy) {
-    return c_bigint<FR>(bigint_x<FR>::ValueType::one());
+c_uint8<FR> one(const uint8_x<FR>& dummy) {
+    return c_uint8<FR>(1);
 }
 
 template <typename FR, std::size_t N>
-std::array<c_bigint<FR>, N> zero(const std::array<bigint_x<FR>, N>& dummy) {
-    std::array<c_bigint<FR>, N> a;
+std::array<c_uint8<FR>, N> zero(const std::array<uint8_x<FR>, N>& dummy) {
+    std::array<c_uint8<FR>, N> a;
 
     for (std::size_t i = 0; i < N; ++i)
         a[i] = zero(dummy[i]);
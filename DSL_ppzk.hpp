@@ -44,6 +44,13 @@ std::size_t variable_count()
         ->counterID();
 }
 
+template <typename PAIRING>
+std::size_t constraint_count()
+{
+    return TL<R1C<typename PAIRING::Fr>>::singleton()
+        ->constraintCount();
+}
+
 template <typename PAIRING>
 snarklib::PPZK_Keypair<PAIRING> keypair()
 {
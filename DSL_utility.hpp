@@ -6,6 +6,7 @@
 #include <iostream>
 #include <istream>
 #include <ostream>
+#include <type_traits>
 #include <vector>
 #include "AST.hpp"
 
@@ -124,6 +125,60 @@ std::istream& operator>> (std::istream& is,
     return is;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// serialize field element digests (algebraic hash functions)
+// (only types with a static one(), other arrays such as byte digests
+// are not matched)
+//
+
+template <typename FR, std::size_t N>
+typename std::enable_if<std::is_same<decltype(FR::one()), FR>::value,
+                        std::ostream&>::type
+operator<< (std::ostream& os,
+            const std::array<FR, N>& a) {
+    for (const auto& r : a)
+        os << r << std::endl;
+    return os;
+}
+
+template <typename FR, std::size_t N>
+typename std::enable_if<std::is_same<decltype(FR::one()), FR>::value,
+                        std::ostream&>::type
+operator<< (std::ostream& os,
+            const std::vector<std::array<FR, N>>& a) {
+    os << a.size() << std::endl;
+
+    for (const auto& r : a)
+        os << r;
+
+    return os;
+}
+
+template <typename FR, std::size_t N>
+typename std::enable_if<std::is_same<decltype(FR::one()), FR>::value,
+                        std::istream&>::type
+operator>> (std::istream& is,
+            std::array<FR, N>& a) {
+    for (auto& r : a)
+        if (!(is >> r)) break;
+    return is;
+}
+
+template <typename FR, std::size_t N>
+typename std::enable_if<std::is_same<decltype(FR::one()), FR>::value,
+                        std::istream&>::type
+operator>> (std::istream& is,
+            std::vector<std::array<FR, N>>& a) {
+    std::size_t len = -1;
+    if (!(is >> len) || (-1 == len)) return is;
+
+    a.resize(len);
+    for (auto& r : a)
+        if (!(is >> r)) break;
+
+    return is;
+}
+
 } // namespace snarkfront
 
 #endif
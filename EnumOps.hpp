@@ -2,6 +2,7 @@
 #define _SNARKFRONT_ENUM_OPS_HPP_
 
 #include <cstdint>
+#include "BigIntOps.hpp"
 #include "BitwiseOps.hpp"
 #include "PowersOf2.hpp"
 
@@ -9,8 +10,8 @@ namespace snarkfront {
 
 // logical and arithmetic
 enum class LogicalOps { AND, OR, XOR, SAME, CMPLMNT };
-enum class ScalarOps { ADD, SUB, MUL };
-enum class BitwiseOps { AND, OR, XOR, SAME, CMPLMNT, ADDMOD, SHL, SHR, ROTL, ROTR };
+enum class ScalarOps { ADD, SUB, MUL, DIV };
+enum class BitwiseOps { AND, OR, XOR, SAME, CMPLMNT, ADDMOD, MULMOD, SHL, SHR, ROTL, ROTR };
 
 // comparison
 enum class EqualityCmp { EQ, NEQ };
@@ -39,6 +40,12 @@ T evalOp(const LogicalOps op, const T& x, const T& y)
     }
 }
 
+// field division (BigInt overload in BigIntOps.hpp rounds down)
+template <typename T>
+T divOp(const T& x, const T& y) {
+    return x * inverse(y);
+}
+
 // evaluate scalar arithmetic operations
 template <typename T>
 T evalOp(const ScalarOps op, const T& x, const T& y)
@@ -47,6 +54,7 @@ T evalOp(const ScalarOps op, const T& x, const T& y)
     case (ScalarOps::ADD) : return x + y;
     case (ScalarOps::SUB) : return x - y;
     case (ScalarOps::MUL) : return x * y;
+    case (ScalarOps::DIV) : return divOp(x, y);
     }
 }
 
@@ -63,6 +71,7 @@ T evalOp(const BitwiseOps op, const T& x, const T& y)
     case (BitwiseOps::SAME) : return B::CMPLMNT(B::XOR(x, y));
     case (BitwiseOps::CMPLMNT) : return B::CMPLMNT(x);
     case (BitwiseOps::ADDMOD) : return B::ADDMOD(x, y);
+    case (BitwiseOps::MULMOD) : return B::MULMOD(x, y);
     case (BitwiseOps::SHL) : return B::SHL(x, y);
     case (BitwiseOps::SHR) : return B::SHR(x, y);
     case (BitwiseOps::ROTL) : return B::ROTL(x, y);
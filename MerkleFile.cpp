@@ -0,0 +1,209 @@
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "DSL_base.hpp"
+#include "MerkleFile.hpp"
+#include "SHA_256.hpp"
+
+using namespace std;
+
+namespace snarkfront {
+
+////////////////////////////////////////////////////////////////////////////////
+// memory-mapped file
+//
+
+MappedFile::MappedFile()
+    : m_fd(-1),
+      m_data(nullptr),
+      m_size(0)
+{}
+
+MappedFile::MappedFile(MappedFile&& other)
+    : m_fd(other.m_fd),
+      m_data(other.m_data),
+      m_size(other.m_size)
+{
+    other.m_fd = -1;
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+MappedFile& MappedFile::operator= (MappedFile&& other) {
+    if (this != &other) {
+        close();
+        swap(m_fd, other.m_fd);
+        swap(m_data, other.m_data);
+        swap(m_size, other.m_size);
+    }
+
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const string& path) {
+    close();
+
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (-1 == m_fd) return false;
+
+    struct stat st;
+    if (-1 == fstat(m_fd, &st)) {
+        close();
+        return false;
+    }
+
+    // empty file is not mapped until it grows
+    if (st.st_size > 0) {
+        void* p = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (MAP_FAILED == p) {
+            close();
+            return false;
+        }
+
+        m_data = static_cast<char*>(p);
+        m_size = st.st_size;
+    }
+
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data) munmap(m_data, m_size);
+    if (-1 != m_fd) ::close(m_fd);
+
+    m_fd = -1;
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool MappedFile::isOpen() const {
+    return -1 != m_fd;
+}
+
+size_t MappedFile::size() const {
+    return m_size;
+}
+
+bool MappedFile::reserve(const size_t numBytes) {
+    if (-1 == m_fd) return false;
+    if (numBytes <= m_size) return true;
+
+    // at least one page, file size doubles
+    const size_t newSize = max(max(numBytes, 2 * m_size), size_t(4096));
+
+    if (-1 == ftruncate(m_fd, newSize)) return false;
+
+    void* p = mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (MAP_FAILED == p) return false;
+
+    if (m_data) munmap(m_data, m_size);
+
+    m_data = static_cast<char*>(p);
+    m_size = newSize;
+
+    return true;
+}
+
+char* MappedFile::data() {
+    return m_data;
+}
+
+const char* MappedFile::data() const {
+    return m_data;
+}
+
+bool MappedFile::sync() const {
+    if (-1 == m_fd) return false;
+
+    return (!m_data || 0 == msync(m_data, m_size, MS_SYNC))
+        && 0 == fsync(m_fd);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Merkle tree footer
+//
+
+static vector<uint8_t> footerDigest(const vector<uint8_t>& body) {
+    vector<uint8_t> v;
+    for (const auto w : digest(eval::SHA256(), body))
+        for (int i = 3; i >= 0; --i)
+            v.push_back(w >> (8 * i));
+
+    return v;
+}
+
+// write all bytes then flush to disk
+static bool writeFile(const string& path, const vector<uint8_t>& v) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (-1 == fd) return false;
+
+    size_t n = 0;
+    while (n < v.size()) {
+        const ssize_t m = write(fd, v.data() + n, v.size() - n);
+        if (m <= 0) break;
+        n += m;
+    }
+
+    const bool ok = (v.size() == n) && (0 == fsync(fd));
+    return (0 == ::close(fd)) && ok;
+}
+
+bool writeMerkleFooter(const string& path, const vector<uint8_t>& body) {
+    auto v = body;
+    const auto d = footerDigest(body);
+    v.insert(v.end(), d.begin(), d.end());
+
+    const string tmpPath = path + ".tmp";
+    if (! writeFile(tmpPath, v)) return false;
+
+    if (0 != rename(tmpPath.c_str(), path.c_str())) return false;
+
+    // rename is durable when the directory is synced
+    const auto slash = path.find_last_of('/');
+    const string dir = (string::npos == slash) ? "." : path.substr(0, slash + 1);
+
+    const int fd = ::open(dir.c_str(), O_RDONLY);
+    if (-1 == fd) return false;
+    const bool ok = (0 == fsync(fd));
+    ::close(fd);
+
+    return ok;
+}
+
+bool existsMerkleFooter(const string& path) {
+    struct stat st;
+    return 0 == stat(path.c_str(), &st);
+}
+
+bool readMerkleFooter(const string& path, vector<uint8_t>& body) {
+    body.clear();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (-1 == fd) return false;
+
+    vector<uint8_t> v;
+    uint8_t buf[4096];
+    ssize_t m;
+    while ((m = read(fd, buf, sizeof(buf))) > 0)
+        v.insert(v.end(), buf, buf + m);
+
+    ::close(fd);
+
+    if (m < 0 || v.size() < 32) return false;
+
+    body.assign(v.begin(), v.end() - 32);
+    if (footerDigest(body) != vector<uint8_t>(v.end() - 32, v.end())) {
+        body.clear();
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace snarkfront
@@ -0,0 +1,330 @@
+#ifndef _SNARKFRONT_MERKLE_FILE_HPP_
+#define _SNARKFRONT_MERKLE_FILE_HPP_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "MerkleTree.hpp"
+
+namespace snarkfront {
+
+////////////////////////////////////////////////////////////////////////////////
+// memory-mapped file (POSIX)
+//
+
+class MappedFile
+{
+public:
+    MappedFile();
+    MappedFile(MappedFile&& other);
+    MappedFile& operator= (MappedFile&& other);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator= (const MappedFile&) = delete;
+
+    // open or create file, all of it is mapped
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const;
+
+    // mapped bytes (file size)
+    std::size_t size() const;
+
+    // grow file to at least this many bytes (doubles) and map it again
+    bool reserve(const std::size_t numBytes);
+
+    char* data();
+    const char* data() const;
+
+    // write dirty pages to disk
+    bool sync() const;
+
+private:
+    int m_fd;
+    char* m_data;
+    std::size_t m_size;
+};
+
+// footer is followed by its SHA-256 digest, written to a temporary file
+// then renamed over the old footer (atomic)
+bool writeMerkleFooter(const std::string& path,
+                       const std::vector<std::uint8_t>& body);
+
+// true if there is a footer file (it may still be corrupt)
+bool existsMerkleFooter(const std::string& path);
+
+// false if missing or the digest does not match
+bool readMerkleFooter(const std::string& path,
+                      std::vector<std::uint8_t>& body);
+
+////////////////////////////////////////////////////////////////////////////////
+// level of Merkle tree nodes in a memory-mapped file
+//
+// Only the last node in a level can change (it is the right edge of the
+// tree) so it is kept in memory. The file is append-only: a node is
+// written when another is added after it. The last node is saved in the
+// footer instead.
+//
+
+template <typename T>
+class MerkleFileLevel
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "digest must be plain words");
+
+public:
+    MerkleFileLevel()
+        : m_size(0),
+          m_tail(),
+          m_ok(true)
+    {}
+
+    // size is number of nodes including last node (tail)
+    bool open(const std::string& path, const std::size_t size, const T& tail) {
+        m_size = 0;
+        m_ok = m_file.open(path);
+        if (! m_ok) return false;
+
+        // nodes before the last one must be in the file
+        if (size > 0 && m_file.size() < (size - 1) * sizeof(T)) {
+            m_ok = false;
+            return false;
+        }
+
+        m_size = size;
+        m_tail = tail;
+        return true;
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    T& operator[] (const std::size_t index) {
+        return (m_size - 1 == index) ? m_tail : node(index);
+    }
+
+    const T& operator[] (const std::size_t index) const {
+        return (m_size - 1 == index) ? m_tail : node(index);
+    }
+
+    void emplace_back(const T& a) {
+        if (m_size > 0) store(m_size - 1, m_tail);
+        m_tail = a;
+        ++m_size;
+    }
+
+    // only grows, new nodes are zero
+    void resize(const std::size_t size) {
+#ifdef USE_ASSERT
+        assert(size >= m_size);
+#endif
+
+        if (size > m_size && m_size > 0) {
+            // reserve all at once rather than doubling one node at a time
+            m_ok = m_ok && m_file.reserve((size - 1) * sizeof(T));
+        }
+
+        while (m_size < size)
+            emplace_back(T());
+    }
+
+    // false if the file could not grow (nodes were lost)
+    bool ok() const {
+        return m_ok;
+    }
+
+    bool sync() const {
+        return m_ok && m_file.sync();
+    }
+
+private:
+    T& node(const std::size_t index) {
+        return *reinterpret_cast<T*>(m_file.data() + index * sizeof(T));
+    }
+
+    const T& node(const std::size_t index) const {
+        return *reinterpret_cast<const T*>(m_file.data() + index * sizeof(T));
+    }
+
+    void store(const std::size_t index, const T& a) {
+        if (m_file.size() < (index + 1) * sizeof(T)
+            && !m_file.reserve((index + 1) * sizeof(T)))
+        {
+            m_ok = false;
+            return;
+        }
+
+        std::memcpy(m_file.data() + index * sizeof(T), &a, sizeof(T));
+    }
+
+    MappedFile m_file;
+    std::size_t m_size;
+    T m_tail;
+    bool m_ok;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Merkle tree in a directory of memory-mapped files
+//
+// There is one file per level and a footer with the level sizes, the
+// last node of each level (the root is the last node of the top level)
+// and a checksum. Opening maps the files and reads the footer, no nodes
+// are read. Leaves added after the last commit() are lost in a crash,
+// the tree is as it was when committed.
+//
+// Digests are stored in host byte order.
+//
+
+template <typename HASH>
+class MerkleFileStore
+    : public MerkleStore<HASH, MerkleFileLevel<typename HASH::DigType>>
+{
+    typedef MerkleStore<HASH, MerkleFileLevel<typename HASH::DigType>> Base;
+
+public:
+    typedef typename HASH::DigType DigType;
+
+    MerkleFileStore() = default;
+
+    // open tree in directory, new tree if there is no footer
+    // (false if the footer is corrupt, it is never overwritten)
+    bool open(const std::string& dir, const std::size_t depth) {
+        this->m_levels.clear(); // use as valid flag
+        m_dir = dir;
+
+        std::vector<std::uint64_t> sizes(depth + 1, 0);
+        std::vector<DigType> tails(depth + 1, Base::zero());
+
+        const bool exists = existsMerkleFooter(footerPath());
+
+        if (exists) {
+            std::vector<std::uint8_t> body;
+            if (! readMerkleFooter(footerPath(), body)
+                || ! parseFooter(body, depth, sizes, tails)) return false;
+        } else {
+            // root of empty tree
+            sizes[depth] = 1;
+        }
+
+        std::vector<MerkleFileLevel<DigType>> levels(depth + 1);
+        for (std::size_t i = 0; i <= depth; ++i) {
+            if (! levels[i].open(levelPath(i), sizes[i], tails[i]))
+                return false;
+        }
+
+        this->m_depth = depth;
+        this->m_levels.swap(levels);
+        this->m_clean = this->size();
+
+        return exists || commit();
+    }
+
+    bool isOpen() const {
+        return ! this->m_levels.empty();
+    }
+
+    // hash nodes, write level files to disk, then replace footer
+    bool commit() {
+        if (! isOpen()) return false;
+
+        this->hashDirty();
+
+        for (const auto& level : this->m_levels) {
+            if (! level.sync()) return false;
+        }
+
+        return writeMerkleFooter(footerPath(), footer());
+    }
+
+private:
+    std::string footerPath() const {
+        return m_dir + "/footer";
+    }
+
+    std::string levelPath(const std::size_t i) const {
+        return m_dir + "/level_" + std::to_string(i);
+    }
+
+    // magic, depth, digest bytes, level sizes, last node of each level
+    std::vector<std::uint8_t> footer() const {
+        std::vector<std::uint8_t> v(magic().begin(), magic().end());
+
+        pushWord(v, this->m_depth);
+        pushWord(v, sizeof(DigType));
+
+        for (const auto& level : this->m_levels)
+            pushWord(v, level.size());
+
+        for (const auto& level : this->m_levels) {
+            const DigType a = level.size() ? level[level.size() - 1] : Base::zero();
+            const auto p = reinterpret_cast<const std::uint8_t*>(&a);
+            v.insert(v.end(), p, p + sizeof(DigType));
+        }
+
+        return v;
+    }
+
+    static bool parseFooter(const std::vector<std::uint8_t>& v,
+                            const std::size_t depth,
+                            std::vector<std::uint64_t>& sizes,
+                            std::vector<DigType>& tails)
+    {
+        const std::size_t
+            headerBytes = magic().size() + 8 * (depth + 3),
+            numBytes = headerBytes + sizeof(DigType) * (depth + 1);
+
+        if (numBytes != v.size()
+            || ! std::equal(magic().begin(), magic().end(), v.begin())
+            || depth != getWord(v, magic().size())
+            || sizeof(DigType) != getWord(v, magic().size() + 8))
+            return false;
+
+        for (std::size_t i = 0; i <= depth; ++i) {
+            sizes[i] = getWord(v, magic().size() + 8 * (i + 2));
+
+            std::memcpy(&tails[i],
+                        v.data() + headerBytes + sizeof(DigType) * i,
+                        sizeof(DigType));
+        }
+
+        return 1 == sizes[depth];
+    }
+
+    static const std::string& magic() {
+        static const std::string a = "snarkmt1";
+        return a;
+    }
+
+    static void pushWord(std::vector<std::uint8_t>& v, const std::uint64_t a) {
+        for (std::size_t i = 0; i < 8; ++i)
+            v.push_back(a >> (8 * i));
+    }
+
+    static std::uint64_t getWord(const std::vector<std::uint8_t>& v,
+                                 const std::size_t offset) {
+        std::uint64_t a = 0;
+        for (std::size_t i = 0; i < 8; ++i)
+            a |= std::uint64_t(v[offset + i]) << (8 * i);
+        return a;
+    }
+
+    std::string m_dir;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// typedefs
+//
+
+typedef MerkleFileStore<eval::SHA256> MerkleFileStore_SHA256;
+typedef MerkleFileStore<eval::SHA512> MerkleFileStore_SHA512;
+
+} // namespace snarkfront
+
+#endif
@@ -1,16 +1,26 @@
 #ifndef _SNARKFRONT_MERKLE_TREE_HPP_
 #define _SNARKFRONT_MERKLE_TREE_HPP_
 
+#include <algorithm>
 #include <array>
+#include <cassert>
 #include <cstdint>
 #include <iostream>
 #include <istream>
+#include <map>
 #include <ostream>
 #include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "DSL_base.hpp"
 #include "DSL_bless.hpp"
+#include "DSL_ppzk.hpp"
 #include "DSL_utility.hpp"
+#include "MiMC.hpp"
 #include "PowersOf2.hpp"
 #include "SHA_256.hpp"
 #include "SHA_512.hpp"
@@ -46,6 +56,16 @@ public:
         }
     }
 
+    // eval from tree nodes (MerkleStore)
+    MerkleAuthPath(const std::vector<DigType>& siblings,
+                   const std::vector<BIT>& childBits,
+                   const std::vector<DigType>& rootPath)
+        : m_depth(siblings.size()),
+          m_rootPath(rootPath),
+          m_siblings(siblings),
+          m_childBits(childBits)
+    {}
+
     // zk from eval
     template <typename OTHER_HASH, typename OTHER_BIT>
     MerkleAuthPath(const MerkleAuthPath<OTHER_HASH, OTHER_BIT>& other)
@@ -106,10 +126,9 @@ public:
         for (std::size_t i = 0; i < m_depth; ++i) {
             hashAlgo.clearMessage();
 
-            const auto& isRightChild = m_childBits[i];
-            const auto
-                leftDigest = ternary(isRightChild, m_siblings[i], dig),
-                rightDigest = ternary(isRightChild, dig, m_siblings[i]);
+            // left and right children are swapped if this is the right child
+            auto leftDigest = dig, rightDigest = m_siblings[i];
+            cswap(m_childBits[i], leftDigest, rightDigest);
 
             hashAlgo.msgInput(leftDigest);
             hashAlgo.msgInput(rightDigest);
@@ -216,7 +235,7 @@ public:
 private:
     // note: not called by proof generation
     static DigType zero() {
-        return {0};
+        return DigType(); // words or field elements
     }
 
     std::size_t m_depth;
@@ -240,6 +259,288 @@ std::istream& operator>> (std::istream& is, MerkleAuthPath<HASH, BIT>& a) {
     return is;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// authentication paths of many leaves in one binary Merkle tree
+//
+// Internal nodes shared by paths are hashed once. The leaves are sorted
+// by leaf number and, level by level, two nodes that are siblings are
+// hashed together. Any other node is hashed with its sibling from the
+// authentication path, left or right by its child bit. The number of
+// hashes is the number of distinct nodes above the leaves, so clustered
+// leaves cost much less than one path each.
+//
+// Which nodes are siblings is the shape of the circuit. It shows the
+// levels at which paths join but not the leaf numbers.
+//
+
+template <typename HASH, typename BIT>
+class MerkleMultiPath
+{
+public:
+    typedef HASH HashType;
+    typedef typename HASH::DigType DigType;
+
+    MerkleMultiPath()
+        : m_depth(0)
+    {}
+
+    // eval from authentication paths of different leaves in one tree
+    template <typename PATH>
+    MerkleMultiPath(const std::vector<PATH>& paths)
+        : m_depth(paths.empty() ? 0 : paths.front().depth())
+    {
+        if (paths.empty()) return;
+
+        m_root = paths.front().rootHash();
+
+        // leaf number and path of each node, sorted by leaf number
+        std::vector<std::pair<std::size_t, std::size_t>> nodes;
+        nodes.reserve(paths.size());
+        for (std::size_t k = 0; k < paths.size(); ++k) {
+            std::size_t index = 0;
+            for (std::size_t i = m_depth; i > 0; --i)
+                index = 2 * index + (paths[k].childBits()[i - 1] ? 1 : 0);
+
+            nodes.emplace_back(index, k);
+        }
+
+        std::sort(nodes.begin(), nodes.end());
+
+        m_order.reserve(nodes.size());
+        for (const auto& a : nodes)
+            m_order.emplace_back(a.second);
+
+        m_pairs.resize(m_depth);
+        for (std::size_t i = 0; i < m_depth; ++i) {
+            std::vector<std::pair<std::size_t, std::size_t>> parents;
+            parents.reserve(nodes.size());
+
+            for (std::size_t j = 0; j < nodes.size(); ++j) {
+#ifdef USE_ASSERT
+                assert(j + 1 == nodes.size() || nodes[j].first != nodes[j + 1].first);
+#endif
+
+                const bool isPair =
+                    j + 1 < nodes.size() && (nodes[j].first ^ 1) == nodes[j + 1].first;
+
+                m_pairs[i].push_back(isPair);
+
+                if (! isPair) {
+                    const auto& a = paths[nodes[j].second];
+                    m_siblings.emplace_back(a.siblings()[i]);
+                    m_childBits.emplace_back(a.childBits()[i]);
+                }
+
+                parents.emplace_back(nodes[j].first >> 1, nodes[j].second);
+
+                if (isPair) ++j;
+            }
+
+            nodes.swap(parents);
+        }
+    }
+
+    // zk from eval
+    template <typename OTHER_HASH, typename OTHER_BIT>
+    MerkleMultiPath(const MerkleMultiPath<OTHER_HASH, OTHER_BIT>& other)
+        : m_depth(other.depth()),
+          m_order(other.order()),
+          m_pairs(other.pairs())
+    {
+        m_siblings.reserve(other.siblings().size());
+        for (const auto& a : other.siblings()) {
+            DigType b;
+            bless(b, a);
+            m_siblings.emplace_back(b);
+        }
+
+        m_childBits.reserve(other.childBits().size());
+        for (const auto& a : other.childBits()) {
+            BIT b;
+            bless(b, a);
+            m_childBits.emplace_back(b);
+        }
+    }
+
+    std::size_t depth() const {
+        return m_depth;
+    }
+
+    // number of leaves
+    std::size_t size() const {
+        return m_order.size();
+    }
+
+    // number of internal nodes hashed by updatePath()
+    std::size_t hashCount() const {
+        std::size_t n = 0;
+        for (const auto& a : m_pairs)
+            n += a.size();
+
+        return n;
+    }
+
+    const DigType& rootHash() const {
+        return m_root;
+    }
+
+    // path of each leaf sorted by leaf number
+    const std::vector<std::size_t>& order() const { return m_order; }
+
+    // by level, true if node is hashed with the next node
+    const std::vector<std::vector<int>>& pairs() const { return m_pairs; }
+
+    // of nodes not paired, bottom-up order
+    const std::vector<DigType>& siblings() const { return m_siblings; }
+    const std::vector<BIT>& childBits() const { return m_childBits; }
+
+    // leaves in the same order as the authentication paths
+    void updatePath(const std::vector<DigType>& leaves) {
+#ifdef USE_ASSERT
+        assert(leaves.size() == size());
+#endif
+
+        std::vector<DigType> nodes;
+        nodes.reserve(size());
+        for (const auto& k : m_order)
+            nodes.emplace_back(leaves[k]);
+
+        HASH hashAlgo;
+
+        // ascend tree from leaves to root
+        std::size_t s = 0;
+        for (std::size_t i = 0; i < m_depth; ++i) {
+            std::vector<DigType> parents;
+            parents.reserve(m_pairs[i].size());
+
+            std::size_t j = 0;
+            for (const auto& isPair : m_pairs[i]) {
+                hashAlgo.clearMessage();
+
+                if (isPair) {
+                    hashAlgo.msgInput(nodes[j]);
+                    hashAlgo.msgInput(nodes[j + 1]);
+                    j += 2;
+
+                } else {
+                    // left and right children are swapped if this is the right child
+                    auto leftDigest = nodes[j], rightDigest = m_siblings[s];
+                    cswap(m_childBits[s], leftDigest, rightDigest);
+
+                    hashAlgo.msgInput(leftDigest);
+                    hashAlgo.msgInput(rightDigest);
+                    ++j;
+                    ++s;
+                }
+
+                hashAlgo.computeHash();
+                parents.emplace_back(hashAlgo.digest());
+            }
+
+            nodes.swap(parents);
+        }
+
+        m_root = nodes.front();
+    }
+
+    void marshal_out(std::ostream& os) const {
+        os << m_depth << std::endl
+           << m_root
+           << m_order.size() << std::endl;
+
+        for (const auto& a : m_order)
+            os << a << std::endl;
+
+        for (const auto& level : m_pairs) {
+            os << level.size() << std::endl;
+            for (const auto& a : level)
+                os << a << std::endl;
+        }
+
+        os << m_siblings;
+
+        for (const auto& a : m_childBits)
+            os << a << std::endl;
+    }
+
+    bool marshal_in(std::istream& is) {
+        m_depth = 0; // use as valid flag
+
+        std::size_t depth = 0, len = 0;
+        is >> depth;
+        if (!is || 0 == depth) return false;
+
+        is >> m_root;
+        if (!is) return false;
+
+        is >> len;
+        if (!is || 0 == len) return false;
+
+        m_order.resize(len);
+        for (auto& a : m_order) {
+            if (!(is >> a) || a >= len) return false;
+        }
+
+        // each level has one fewer node for each pair
+        std::size_t numNodes = len, numSiblings = 0;
+        m_pairs.resize(depth);
+        for (auto& level : m_pairs) {
+            if (!(is >> len)) return false;
+
+            level.resize(len);
+            for (auto& a : level) {
+                if (!(is >> a)) return false;
+
+                numNodes -= a ? 2 : 1;
+                if (! a) ++numSiblings;
+            }
+
+            if (0 != numNodes) return false;
+            numNodes = len;
+        }
+
+        if (1 != numNodes) return false;
+
+        is >> m_siblings;
+        if (!is || numSiblings != m_siblings.size()) return false;
+
+        m_childBits.resize(numSiblings);
+        for (auto& a : m_childBits) {
+            if (!(is >> a)) return false;
+        }
+
+        m_depth = depth;
+
+        return true;
+    }
+
+private:
+    std::size_t m_depth;
+    DigType m_root;
+
+    // leaf number order (public)
+    std::vector<std::size_t> m_order;
+
+    // shape of the union of paths (public)
+    std::vector<std::vector<int>> m_pairs;
+
+    // for nodes without a sibling in the union of paths
+    std::vector<DigType> m_siblings;
+    std::vector<BIT> m_childBits;
+};
+
+template <typename HASH, typename BIT>
+std::ostream& operator<< (std::ostream& os, const MerkleMultiPath<HASH, BIT>& a) {
+    a.marshal_out(os);
+    return os;
+}
+
+template <typename HASH, typename BIT>
+std::istream& operator>> (std::istream& is, MerkleMultiPath<HASH, BIT>& a) {
+    a.marshal_in(is);
+    return is;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Merkle tree (binary)
 //
@@ -341,139 +642,1038 @@ std::istream& operator>> (std::istream& is, MerkleTree<HASH>& a) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Merkle tree with authentication paths
+// Merkle tree (binary) with all node digests
+//
+// One array of node digests per level, index 0 is the leaves and the
+// root is the only node at index depth. Empty subtrees have the zero
+// digest (as in MerkleTree).
+//
+// Adding leaves only appends to level 0. Internal nodes above the new
+// leaves are hashed when the root hash or an authentication path is
+// next needed, each node once for any number of added leaves. Nodes in
+// a level are independent, so hashNodes() may divide each level among
+// worker threads.
+//
+// Each LEVEL is a sequence of node digests (std::vector in memory or
+// MerkleFileLevel for a memory-mapped file).
 //
 
-template <typename TREE, typename PATH, typename COUNT>
-class MerkleBundle
+template <typename HASH, typename LEVEL = std::vector<typename HASH::DigType>>
+class MerkleStore
 {
 public:
-    typedef typename TREE::HashType HashType;
-    typedef typename TREE::DigType DigType;
+    typedef HASH HashType;
+    typedef typename HASH::DigType DigType;
+    typedef MerkleAuthPath<HASH, int> PathType;
 
-    MerkleBundle()
-        : m_treeSize(0)
+    MerkleStore()
+        : m_depth(0),
+          m_clean(0)
     {}
 
-    MerkleBundle(const std::size_t depth)
-        : m_tree(depth),
-          m_treeSize(0)
-    {}
+    MerkleStore(const std::size_t depth)
+        : m_depth(depth),
+          m_levels(depth + 1),
+          m_clean(0)
+    {
+        m_levels[depth].emplace_back(zero());
+    }
 
-    bool isFull() const {
-        return m_tree.isFull();
+    std::size_t depth() const {
+        return m_depth;
     }
 
-    COUNT treeSize() const {
-        return m_treeSize;
+    // number of occupied leaves
+    std::size_t size() const {
+        return m_levels.empty() ? 0 : m_levels[0].size();
+    }
+
+    // true when number of occupied leaves is 2^depth
+    bool isFull() const {
+        return m_levels.empty()
+            || (m_depth < 8 * sizeof(std::size_t) && size() >> m_depth);
     }
 
     const DigType& rootHash() const {
-        return m_tree.authPath().rootHash();
+        hashDirty();
+        return m_levels[m_depth][0];
     }
 
-    void addLeaf(const DigType& cm, const bool keepPath = true) {
-        m_tree.updatePath(cm, m_authPath);
+    const DigType& leaf(const std::size_t index) const {
+        return m_levels[0][index];
+    }
 
-        if (keepPath) {
-            m_authLeaf.emplace_back(cm);
-            m_authPath.emplace_back(m_tree.authPath());
-        }
+    // returns leaf index
+    std::size_t addLeaf(const DigType& leaf) {
+#ifdef USE_ASSERT
+        assert(! isFull());
+#endif
 
-        m_tree.updateSiblings(cm);
+        m_levels[0].emplace_back(leaf);
+        return size() - 1;
+    }
 
-        ++m_treeSize;
+    // returns index of first leaf
+    template <typename ITER>
+    std::size_t addLeaves(ITER first, ITER last) {
+        const std::size_t index = size();
+        for (; first != last; ++first)
+            m_levels[0].emplace_back(*first);
+
+#ifdef USE_ASSERT
+        assert(m_depth >= 8 * sizeof(std::size_t)
+               || size() <= std::size_t(1) << m_depth);
+#endif
+
+        return index;
     }
 
-    const std::vector<DigType>& authLeaf() const {
-        return m_authLeaf;
+    std::size_t addLeaves(const std::vector<DigType>& leaves) {
+        return addLeaves(leaves.begin(), leaves.end());
     }
 
-    const std::vector<PATH>& authPath() const {
-        return m_authPath;
+    // hash internal nodes above added leaves now, one level at a time
+    // with worker threads (0 is one thread per core)
+    void hashNodes(const std::size_t threads = 0) const {
+        hashDirty(0 == threads ? std::thread::hardware_concurrency() : threads);
     }
 
-    void authGarbageCollect(const std::set<HashType>& keepSet) {
-        std::vector<DigType> keepLeaf;
-        std::vector<PATH> keepPath;
+    // authentication path for leaf
+    PathType authPath(const std::size_t index) const {
+#ifdef USE_ASSERT
+        assert(index < size());
+#endif
 
-        for (std::size_t i = 0; i < m_authLeaf.size(); ++i) {
-            const auto& cm = m_authLeaf[i];
-            if (keepSet.count(cm)) {
-                keepLeaf.emplace_back(cm);
-                keepPath.emplace_back(m_authPath[i]);
-            }
+        hashDirty();
+
+        std::vector<DigType> siblings, rootPath;
+        std::vector<int> childBits;
+        siblings.reserve(m_depth);
+        rootPath.reserve(m_depth);
+        childBits.reserve(m_depth);
+
+        for (std::size_t i = 0; i < m_depth; ++i) {
+            const std::size_t j = index >> i, k = j ^ 1;
+
+            siblings.emplace_back(
+                k < m_levels[i].size() ? m_levels[i][k] : zero());
+
+            childBits.emplace_back(j & 1);
+            rootPath.emplace_back(m_levels[i + 1][j >> 1]);
         }
 
-        m_authLeaf = keepLeaf;
-        m_authPath = keepPath;
+        return PathType(siblings, childBits, rootPath);
+    }
+
+    // leaf index from child bits of authentication path
+    static std::size_t leafIndex(const PathType& a) {
+        std::size_t index = 0;
+        for (std::size_t i = a.depth(); i > 0; --i)
+            index = 2 * index + (a.childBits()[i - 1] ? 1 : 0);
+
+        return index;
+    }
+
+    // rebuild from the path to the next leaf of a MerkleTree and any
+    // number of leaf authentication paths (all current). Only these
+    // nodes are known, others are zero. Paths for the given leaves and
+    // all leaves added later are correct.
+    void restore(const std::size_t treeSize,
+                 const PathType& nextPath,
+                 const std::vector<DigType>& leaves,
+                 const std::vector<PathType>& paths)
+    {
+        m_depth = nextPath.depth();
+        m_levels.assign(m_depth + 1, LEVEL());
+
+        std::size_t n = treeSize;
+        for (auto& level : m_levels) {
+            level.resize(n, zero());
+            n = (n + 1) / 2;
+        }
+
+        m_clean = treeSize;
+
+        if (0 == treeSize) {
+            m_levels[m_depth].emplace_back(zero());
+            return;
+        }
+
+        m_levels[m_depth][0] = nextPath.rootHash();
+
+        // left siblings of the next leaf
+        for (std::size_t i = 0; i < m_depth; ++i) {
+            const std::size_t j = treeSize >> i;
+            if (j & 1)
+                m_levels[i][j - 1] = nextPath.siblings()[i];
+        }
+
+        for (std::size_t k = 0; k < paths.size(); ++k) {
+            const auto& a = paths[k];
+            const std::size_t index = leafIndex(a);
+
+            m_levels[0][index] = leaves[k];
+
+            for (std::size_t i = 0; i < m_depth; ++i) {
+                const std::size_t j = index >> i, sib = j ^ 1;
+
+                if (sib < m_levels[i].size())
+                    m_levels[i][sib] = a.siblings()[i];
+
+                m_levels[i + 1][j >> 1] = a.rootPath()[i];
+            }
+        }
     }
 
     void marshal_out(std::ostream& os) const {
-        os << m_tree
-           << m_treeSize << std::endl
-           << m_authLeaf;
+        hashDirty();
+
+        os << m_depth << std::endl;
 
-        for (const auto& r : m_authPath)
-            os << r;
+        for (const auto& level : m_levels)
+            os << level;
     }
 
     bool marshal_in(std::istream& is) {
-        if (!m_tree.marshal_in(is) || !(is >> m_treeSize) || !(is >> m_authLeaf))
-            return false;
+        m_levels.clear(); // use as valid flag
+
+        std::size_t depth = 0;
+        is >> depth;
+        if (!is || 0 == depth) return false;
 
-        m_authPath.resize(m_authLeaf.size());
-        for (auto& r : m_authPath) {
-            if (! r.marshal_in(is)) return false;
+        std::vector<LEVEL> levels(depth + 1);
+        for (auto& level : levels) {
+            is >> level;
+            if (!is) return false;
         }
 
+        if (1 != levels[depth].size()) return false;
+
+        m_depth = depth;
+        m_levels.swap(levels);
+        m_clean = size();
+
         return true;
     }
 
-private:
-    TREE m_tree;
-    COUNT m_treeSize;
+protected:
+    static DigType zero() {
+        return DigType(); // words or field elements
+    }
 
-    std::vector<DigType> m_authLeaf;
-    std::vector<PATH> m_authPath;
-};
+    static DigType hashNode(const DigType& left, const DigType& right) {
+        HASH hashAlgo;
+        hashAlgo.msgInput(left);
+        hashAlgo.msgInput(right);
+        hashAlgo.computeHash();
+        return hashAlgo.digest();
+    }
 
-template <typename TREE, typename PATH, typename COUNT>
-std::ostream& operator<< (std::ostream& os,
-                          const MerkleBundle<TREE, PATH, COUNT>& a) {
-    a.marshal_out(os);
-    return os;
-}
+    // hash internal nodes above leaves added since last time
+    void hashDirty(const std::size_t threads = 1) const {
+        if (size() == m_clean) return;
 
-template <typename TREE, typename PATH, typename COUNT>
-std::istream& operator>> (std::istream& is,
-                          MerkleBundle<TREE, PATH, COUNT>& a) {
-    a.marshal_in(is);
-    return is;
-}
+        // dirty nodes are [first, last) in each level
+        std::size_t first = m_clean, last = size();
+        for (std::size_t i = 0; i < m_depth; ++i) {
+            first >>= 1;
+            last = (last + 1) >> 1;
 
-////////////////////////////////////////////////////////////////////////////////
-// typedefs
-//
+            auto& parent = m_levels[i + 1];
+            if (parent.size() < last) parent.resize(last);
 
-namespace zk {
-    template <typename FR> using MerkleAuthPath_SHA256 = MerkleAuthPath<SHA256<FR>, bool_x<FR>>;
-    template <typename FR> using MerkleAuthPath_SHA512 = MerkleAuthPath<SHA512<FR>, bool_x<FR>>;
-} // namespace zk
+            // small levels are not worth starting threads
+            const std::size_t
+                n = last - first,
+                numThreads = std::max<std::size_t>(1, std::min(threads, n / 1024));
 
-namespace eval {
-    typedef MerkleAuthPath<SHA256, int> MerkleAuthPath_SHA256;
-    typedef MerkleAuthPath<SHA512, int> MerkleAuthPath_SHA512;
-} // namespace eval
+            if (1 == numThreads) {
+                hashLevel(i, first, last);
+
+            } else {
+                std::vector<std::thread> workers;
+                workers.reserve(numThreads);
+
+                for (std::size_t t = 0; t < numThreads; ++t) {
+                    workers.emplace_back(&MerkleStore::hashLevel,
+                                         this,
+                                         i,
+                                         first + n * t / numThreads,
+                                         first + n * (t + 1) / numThreads);
+                }
+
+                for (auto& w : workers)
+                    w.join();
+            }
+        }
+
+        m_clean = size();
+    }
+
+    // parents [first, last) of nodes in level i
+    void hashLevel(const std::size_t i,
+                   const std::size_t first,
+                   const std::size_t last) const
+    {
+        const auto& level = m_levels[i];
+        auto& parent = m_levels[i + 1];
+
+        for (std::size_t j = first; j < last; ++j) {
+            parent[j] = hashNode(level[2 * j],
+                                 2 * j + 1 < level.size()
+                                     ? level[2 * j + 1]
+                                     : zero());
+        }
+    }
+
+    std::size_t m_depth;
+
+    // node digests by level, index 0 is the leaves
+    // (internal nodes are hashed lazily)
+    mutable std::vector<LEVEL> m_levels;
+
+    // leaves before this have all internal nodes hashed
+    mutable std::size_t m_clean;
+};
+
+template <typename HASH, typename LEVEL>
+std::ostream& operator<< (std::ostream& os, const MerkleStore<HASH, LEVEL>& a) {
+    a.marshal_out(os);
+    return os;
+}
+
+template <typename HASH, typename LEVEL>
+std::istream& operator>> (std::istream& is, MerkleStore<HASH, LEVEL>& a) {
+    a.marshal_in(is);
+    return is;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// hash table key for digests
+//
+// Digest words are already uniform so the first ones are enough. Field
+// element digests are hashed as marshalled text (slower).
+//
+
+class MerkleDigestHash
+{
+public:
+    template <std::size_t N>
+    std::size_t operator() (const std::array<std::uint32_t, N>& a) const {
+        return std::hash<std::uint64_t>()(std::uint64_t(a[0]) << 32 | a[N - 1]);
+    }
+
+    template <std::size_t N>
+    std::size_t operator() (const std::array<std::uint64_t, N>& a) const {
+        return std::hash<std::uint64_t>()(a[0] ^ a[N - 1]);
+    }
+
+    template <typename T, std::size_t N>
+    std::size_t operator() (const std::array<T, N>& a) const {
+        std::stringstream ss;
+        ss << a;
+        return std::hash<std::string>()(ss.str());
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Merkle tree with authentication paths
+//
+// Kept leaves are leaf numbers in the tree, their authentication paths
+// are read from the tree when needed. A hash table from leaf digest to
+// kept position finds and removes kept leaves in constant time. A digest
+// is kept once, for the last leaf added with it.
+//
+// Marshalled format 2 is the tree, tree size, kept leaves and leaf
+// numbers. Format 1 (a MerkleTree, tree size, kept leaves and their
+// authentication paths) is read too. It begins with the MerkleTree full
+// flag, 0 or 1.
+//
+
+template <typename TREE, typename PATH, typename COUNT>
+class MerkleBundle
+{
+public:
+    typedef typename TREE::HashType HashType;
+    typedef typename TREE::DigType DigType;
+
+    MerkleBundle()
+        : m_treeSize(0)
+    {}
+
+    MerkleBundle(const std::size_t depth)
+        : m_tree(depth),
+          m_treeSize(0)
+    {}
+
+    bool isFull() const {
+        return m_tree.isFull();
+    }
+
+    COUNT treeSize() const {
+        return m_treeSize;
+    }
+
+    const DigType& rootHash() const {
+        return m_tree.rootHash();
+    }
+
+    const TREE& tree() const {
+        return m_tree;
+    }
+
+    void addLeaf(const DigType& cm, const bool keepPath = true) {
+        const std::size_t index = m_tree.addLeaf(cm);
+
+        if (keepPath) authKeep(cm, index);
+
+        ++m_treeSize;
+    }
+
+    // root hash is updated once when next needed
+    template <typename ITER>
+    void addLeaves(ITER first, ITER last, const bool keepPath = false) {
+        const std::size_t index = m_tree.addLeaves(first, last);
+
+        if (keepPath) {
+            for (std::size_t i = index; i < m_tree.size(); ++i)
+                authKeep(m_tree.leaf(i), i);
+        }
+
+        m_treeSize += m_tree.size() - index;
+    }
+
+    void addLeaves(const std::vector<DigType>& cm, const bool keepPath = false) {
+        addLeaves(cm.begin(), cm.end(), keepPath);
+    }
+
+    // hash tree nodes now with worker threads (0 is one per core)
+    void hashNodes(const std::size_t threads = 0) const {
+        m_tree.hashNodes(threads);
+    }
+
+    const std::vector<DigType>& authLeaf() const {
+        return m_authLeaf;
+    }
+
+    // leaf numbers of kept leaves
+    const std::vector<COUNT>& authIndex() const {
+        return m_authIndex;
+    }
+
+    // authentication path of kept leaf i
+    PATH authPath(const std::size_t i) const {
+        return m_tree.authPath(m_authIndex[i]);
+    }
+
+    // authentication paths of all kept leaves
+    std::vector<PATH> authPath() const {
+        std::vector<PATH> v;
+        v.reserve(m_authIndex.size());
+        for (const auto& index : m_authIndex)
+            v.emplace_back(m_tree.authPath(index));
+
+        return v;
+    }
+
+    // true if leaf digest is kept
+    bool authContains(const DigType& cm) const {
+        return m_authMap.count(cm);
+    }
+
+    // position of kept leaf in authLeaf() or -1
+    std::size_t authFind(const DigType& cm) const {
+        const auto it = m_authMap.find(cm);
+        return m_authMap.end() == it ? std::size_t(-1) : it->second;
+    }
+
+    // authentication path of kept leaf digest
+    bool authPath(const DigType& cm, PATH& path) const {
+        const std::size_t i = authFind(cm);
+        if (std::size_t(-1) == i) return false;
+
+        path = authPath(i);
+        return true;
+    }
+
+    // stop keeping leaf digest, the last kept leaf takes its position
+    bool authRemove(const DigType& cm) {
+        const auto it = m_authMap.find(cm);
+        if (m_authMap.end() == it) return false;
+
+        const std::size_t i = it->second, last = m_authLeaf.size() - 1;
+        m_authMap.erase(it);
+
+        if (i != last) {
+            m_authLeaf[i] = m_authLeaf[last];
+            m_authIndex[i] = m_authIndex[last];
+            m_authMap[m_authLeaf[i]] = i;
+        }
+
+        m_authLeaf.pop_back();
+        m_authIndex.pop_back();
+
+        return true;
+    }
+
+    // returns number removed, others are not moved except to fill gaps
+    template <typename ITER>
+    std::size_t authRemove(ITER first, ITER last) {
+        std::size_t n = 0;
+        for (; first != last; ++first) {
+            if (authRemove(*first)) ++n;
+        }
+
+        return n;
+    }
+
+    std::size_t authRemove(const std::vector<DigType>& cm) {
+        return authRemove(cm.begin(), cm.end());
+    }
+
+    // remove kept leaves not in the set, order is unchanged
+    void authGarbageCollect(const std::set<DigType>& keepSet) {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < m_authLeaf.size(); ++i) {
+            if (! keepSet.count(m_authLeaf[i])) {
+                m_authMap.erase(m_authLeaf[i]);
+
+            } else {
+                if (n != i) {
+                    m_authLeaf[n] = m_authLeaf[i];
+                    m_authIndex[n] = m_authIndex[i];
+                    m_authMap[m_authLeaf[n]] = n;
+                }
+
+                ++n;
+            }
+        }
+
+        m_authLeaf.resize(n);
+        m_authIndex.resize(n);
+    }
+
+    void marshal_out(std::ostream& os) const {
+        os << 2 << std::endl // format
+           << m_tree
+           << m_treeSize << std::endl
+           << m_authLeaf;
+
+        for (const auto& r : m_authIndex)
+            os << r << std::endl;
+    }
+
+    bool marshal_in(std::istream& is) {
+        int format = -1;
+        if (!(is >> format)) return false;
+
+        if (2 == format) {
+            if (!m_tree.marshal_in(is) || !(is >> m_treeSize) || !(is >> m_authLeaf))
+                return false;
+
+            m_authIndex.resize(m_authLeaf.size());
+            for (auto& r : m_authIndex) {
+                if (!(is >> r) || r >= m_treeSize) return false;
+            }
+
+            authRehash();
+
+            return true;
+
+        } else if (0 == format || 1 == format) {
+            // MerkleTree full flag already read, then the path to the
+            // next leaf (format 1)
+            PATH nextPath;
+            if (!nextPath.marshal_in(is) || !(is >> m_treeSize) || !(is >> m_authLeaf))
+                return false;
+
+            std::vector<PATH> paths(m_authLeaf.size());
+            m_authIndex.clear();
+            m_authIndex.reserve(paths.size());
+            for (auto& r : paths) {
+                if (!r.marshal_in(is) || r.depth() != nextPath.depth())
+                    return false;
+
+                m_authIndex.emplace_back(TREE::leafIndex(r));
+                if (m_authIndex.back() >= m_treeSize) return false;
+            }
+
+            m_tree.restore(m_treeSize, nextPath, m_authLeaf, paths);
+
+            authRehash();
+
+            return true;
+
+        } else {
+            return false;
+        }
+    }
+
+private:
+    void authKeep(const DigType& cm, const std::size_t index) {
+        const auto it = m_authMap.find(cm);
+
+        if (m_authMap.end() == it) {
+            m_authMap[cm] = m_authLeaf.size();
+            m_authLeaf.emplace_back(cm);
+            m_authIndex.emplace_back(index);
+
+        } else {
+            // same digest again, keep the later leaf
+            m_authIndex[it->second] = index;
+        }
+    }
+
+    // hash table from kept leaves, only the last of equal digests is kept
+    void authRehash() {
+        std::vector<DigType> leaf;
+        std::vector<COUNT> index;
+        leaf.swap(m_authLeaf);
+        index.swap(m_authIndex);
+
+        m_authMap.clear();
+        m_authMap.reserve(leaf.size());
+
+        for (std::size_t i = 0; i < leaf.size(); ++i)
+            authKeep(leaf[i], index[i]);
+    }
+
+    TREE m_tree;
+    COUNT m_treeSize;
+
+    std::vector<DigType> m_authLeaf;
+    std::vector<COUNT> m_authIndex;
+
+    // kept leaf digest to position in m_authLeaf and m_authIndex
+    std::unordered_map<DigType, std::size_t, MerkleDigestHash> m_authMap;
+};
+
+template <typename TREE, typename PATH, typename COUNT>
+std::ostream& operator<< (std::ostream& os,
+                          const MerkleBundle<TREE, PATH, COUNT>& a) {
+    a.marshal_out(os);
+    return os;
+}
+
+template <typename TREE, typename PATH, typename COUNT>
+std::istream& operator>> (std::istream& is,
+                          MerkleBundle<TREE, PATH, COUNT>& a) {
+    a.marshal_in(is);
+    return is;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// complete tree from leaves, same root and authentication paths as
+// adding one leaf at a time. Each level is hashed by worker threads (0
+// is one per core) before the level above.
+//
+
+template <typename TREE>
+TREE makeMerkleTree(const std::size_t depth,
+                    const std::vector<typename TREE::DigType>& leaves,
+                    const std::size_t threads = 0)
+{
+    TREE a(depth);
+    a.addLeaves(leaves);
+    a.hashNodes(threads);
+    return a;
+}
+
+template <typename BUNDLE>
+BUNDLE makeMerkleBundle(const std::size_t depth,
+                        const std::vector<typename BUNDLE::DigType>& leaves,
+                        const bool keepPath = false,
+                        const std::size_t threads = 0)
+{
+    BUNDLE a(depth);
+    a.addLeaves(leaves, keepPath);
+    a.hashNodes(threads);
+    return a;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// sparse Merkle tree (binary) with 256-bit keys
+//
+// A leaf is at any key, not only the next leaf number. The low depth
+// bits of the key are the leaf index, bit i is the child bit at level i.
+// Keys are SHA-256 digest words (big-endian, word 7 is least
+// significant). Empty leaves are zero. An empty subtree has the digest
+// of two empty children, these are computed once per level. Only nodes
+// above non-empty leaves are stored, so setting a leaf hashes the nodes
+// on one path.
+//
+// An authentication path proves the leaf at its key. The leaf is zero
+// if the key is not in the tree (non-membership). The zk child bits are
+// private, so a proof only shows that some leaf has the value. Callers
+// must bind the path to the key: bless keyBits() as public input before
+// end_input, then assert_key() on the zk path.
+//
+// If depth is less than 256, keys are truncated to the low depth bits.
+// Each leaf keeps its full key. A different key with the same low bits
+// is not contained, and setLeaf() rejects it. The proof binds only the
+// low depth bits, so for keyed use either take depth 256 or hash the
+// full key into the leaf.
+//
+
+template <typename HASH>
+class MerkleSparseTree
+{
+public:
+    typedef HASH HashType;
+    typedef typename HASH::DigType DigType;
+    typedef std::array<std::uint32_t, 8> KeyType;
+    typedef MerkleAuthPath<HASH, int> PathType;
+
+    MerkleSparseTree()
+        : m_depth(0)
+    {}
+
+    MerkleSparseTree(const std::size_t depth)
+        : m_depth(depth),
+          m_nodes(depth + 1)
+    {
+#ifdef USE_ASSERT
+        assert(depth > 0 && depth <= 256);
+#endif
+
+        emptyDigests();
+    }
+
+    std::size_t depth() const {
+        return m_depth;
+    }
+
+    // number of non-empty leaves
+    std::size_t size() const {
+        return m_nodes.empty() ? 0 : m_nodes[0].size();
+    }
+
+    const DigType& rootHash() const {
+        return node(m_depth, KeyType());
+    }
+
+    // digest of empty subtree with leaves at level 0
+    const DigType& emptyHash(const std::size_t level) const {
+        return m_empty[level];
+    }
+
+    // full key, not only the low depth bits
+    bool contains(const KeyType& key) const {
+        const auto it = m_keys.find(leafKey(key));
+        return m_keys.end() != it && key == it->second;
+    }
+
+    // some key has the same low depth bits (the leaf index)
+    bool occupied(const KeyType& key) const {
+        return m_keys.count(leafKey(key));
+    }
+
+    // zero if key is not in tree
+    const DigType& leaf(const KeyType& key) const {
+        return contains(key) ? node(0, leafKey(key)) : m_empty[0];
+    }
+
+    // insert or update, zero leaf is erased
+    // (false if a different key has the same low depth bits)
+    bool setLeaf(const KeyType& key, const DigType& leaf) {
+        KeyType k = leafKey(key);
+
+        const auto it = m_keys.find(k);
+        if (m_keys.end() != it && key != it->second) return false;
+
+        if (zero() == leaf) {
+            m_nodes[0].erase(k);
+            m_keys.erase(k);
+        } else {
+            m_nodes[0][k] = leaf;
+            m_keys[k] = key;
+        }
+
+        // ascend tree from leaf to root
+        for (std::size_t i = 0; i < m_depth; ++i) {
+            KeyType sib = k, parent = k;
+            sib[7] ^= 1;
+            shiftRight(parent);
+
+            if (!m_nodes[i].count(k) && !m_nodes[i].count(sib)) {
+                // subtree is empty
+                m_nodes[i + 1].erase(parent);
+
+            } else if (k[7] & 1) {
+                m_nodes[i + 1][parent] = hashNode(node(i, sib), node(i, k));
+
+            } else {
+                m_nodes[i + 1][parent] = hashNode(node(i, k), node(i, sib));
+            }
+
+            k = parent;
+        }
+
+        return true;
+    }
+
+    bool eraseLeaf(const KeyType& key) {
+        return setLeaf(key, zero());
+    }
+
+    // authentication path for key, leaf may be empty
+    PathType authPath(const KeyType& key) const {
+        std::vector<DigType> siblings, rootPath;
+        std::vector<int> childBits;
+        siblings.reserve(m_depth);
+        rootPath.reserve(m_depth);
+        childBits.reserve(m_depth);
+
+        KeyType k = leafKey(key);
+        for (std::size_t i = 0; i < m_depth; ++i) {
+            KeyType sib = k;
+            sib[7] ^= 1;
+
+            siblings.emplace_back(node(i, sib));
+            childBits.emplace_back(k[7] & 1);
+
+            shiftRight(k);
+            rootPath.emplace_back(node(i + 1, k));
+        }
+
+        return PathType(siblings, childBits, rootPath);
+    }
+
+    // child bits of path to key, leaf to root (public input that binds
+    // a zk authentication path to the key, see assert_key)
+    std::vector<int> keyBits(const KeyType& key) const {
+        const KeyType k = leafKey(key);
+
+        std::vector<int> v;
+        v.reserve(m_depth);
+        for (std::size_t i = 0; i < m_depth; ++i)
+            v.push_back((k[7 - i / 32] >> (i % 32)) & 1);
+
+        return v;
+    }
+
+    // key from child bits of authentication path
+    static KeyType pathKey(const PathType& a) {
+        KeyType k = KeyType();
+        for (std::size_t i = 0; i < a.depth(); ++i) {
+            if (a.childBits()[i])
+                k[7 - i / 32] |= std::uint32_t(1) << (i % 32);
+        }
+
+        return k;
+    }
+
+    // key for leaf number
+    static KeyType indexKey(const std::uint64_t index) {
+        KeyType k = KeyType();
+        k[7] = index;
+        k[6] = index >> 32;
+        return k;
+    }
+
+    // only stored nodes and full keys of leaves, empty subtree digests
+    // are computed again
+    void marshal_out(std::ostream& os) const {
+        os << m_depth << std::endl;
+
+        for (const auto& level : m_nodes) {
+            os << level.size() << std::endl;
+
+            for (const auto& r : level)
+                os << r.first << r.second;
+        }
+
+        os << m_keys.size() << std::endl;
+
+        for (const auto& r : m_keys)
+            os << r.second;
+    }
+
+    bool marshal_in(std::istream& is) {
+        m_depth = 0; // use as valid flag
+        m_nodes.clear();
+        m_keys.clear();
+
+        std::size_t depth = 0;
+        is >> depth;
+        if (!is || 0 == depth || depth > 256) return false;
+
+        std::vector<std::map<KeyType, DigType>> nodes(depth + 1);
+        for (auto& level : nodes) {
+            std::size_t len = 0;
+            if (!(is >> len)) return false;
+
+            for (std::size_t i = 0; i < len; ++i) {
+                KeyType k;
+                DigType a;
+                if (!(is >> k) || !(is >> a)) return false;
+
+                level[k] = a;
+            }
+        }
+
+        if (nodes[depth].size() > 1) return false;
+
+        // full key of every leaf
+        std::size_t len = 0;
+        if (!(is >> len) || nodes[0].size() != len) return false;
+
+        std::map<KeyType, KeyType> keys;
+        for (std::size_t i = 0; i < len; ++i) {
+            KeyType k;
+            if (!(is >> k)) return false;
+
+            const KeyType a = leafKey(k, depth);
+            if (! nodes[0].count(a) || keys.count(a)) return false;
+
+            keys[a] = k;
+        }
+
+        m_depth = depth;
+        m_nodes.swap(nodes);
+        m_keys.swap(keys);
+        emptyDigests();
+
+        return true;
+    }
+
+private:
+    static DigType zero() {
+        return DigType(); // words or field elements
+    }
+
+    static DigType hashNode(const DigType& left, const DigType& right) {
+        HASH hashAlgo;
+        hashAlgo.msgInput(left);
+        hashAlgo.msgInput(right);
+        hashAlgo.computeHash();
+        return hashAlgo.digest();
+    }
+
+    void emptyDigests() {
+        m_empty.clear();
+        m_empty.reserve(m_depth + 1);
+        m_empty.emplace_back(zero());
+
+        for (std::size_t i = 0; i < m_depth; ++i)
+            m_empty.emplace_back(hashNode(m_empty[i], m_empty[i]));
+    }
+
+    // stored node or empty subtree
+    const DigType& node(const std::size_t level, const KeyType& k) const {
+        const auto it = m_nodes[level].find(k);
+        return m_nodes[level].end() == it ? m_empty[level] : it->second;
+    }
+
+    // bits above depth are cleared
+    static KeyType leafKey(const KeyType& key, const std::size_t depth) {
+        KeyType k = key;
+        for (std::size_t i = 0; i < 8; ++i) {
+            const std::size_t lowBit = 32 * (7 - i);
+
+            if (lowBit >= depth) {
+                k[i] = 0;
+            } else if (depth - lowBit < 32) {
+                k[i] &= (std::uint32_t(1) << (depth - lowBit)) - 1;
+            }
+        }
+
+        return k;
+    }
+
+    KeyType leafKey(const KeyType& key) const {
+        return leafKey(key, m_depth);
+    }
+
+    // parent key (divide by two)
+    static void shiftRight(KeyType& k) {
+        for (std::size_t i = 7; i > 0; --i)
+            k[i] = (k[i] >> 1) | (k[i - 1] << 31);
+        k[0] >>= 1;
+    }
+
+    std::size_t m_depth;
+
+    // non-empty nodes by level, index 0 is the leaves
+    std::vector<std::map<KeyType, DigType>> m_nodes;
+
+    // full key of each leaf (low depth bits -> key)
+    std::map<KeyType, KeyType> m_keys;
+
+    // empty subtree digests by level
+    std::vector<DigType> m_empty;
+};
+
+// zk authentication path is for the key, keyBits must be public input
+// (blessed before end_input) or the proof is for any leaf
+template <typename HASH, typename FR>
+void assert_key(const MerkleAuthPath<HASH, bool_x<FR>>& path,
+                const std::vector<bool_x<FR>>& keyBits)
+{
+#ifdef USE_ASSERT
+    assert(path.depth() == keyBits.size());
+#endif
+
+    for (std::size_t i = 0; i < path.depth(); ++i)
+        assert_true(path.childBits()[i] == keyBits[i]);
+}
+
+template <typename HASH>
+std::ostream& operator<< (std::ostream& os, const MerkleSparseTree<HASH>& a) {
+    a.marshal_out(os);
+    return os;
+}
+
+template <typename HASH>
+std::istream& operator>> (std::istream& is, MerkleSparseTree<HASH>& a) {
+    a.marshal_in(is);
+    return is;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// typedefs
+//
+
+namespace zk {
+    template <typename FR> using MerkleAuthPath_SHA256 = MerkleAuthPath<SHA256<FR>, bool_x<FR>>;
+    template <typename FR> using MerkleAuthPath_SHA512 = MerkleAuthPath<SHA512<FR>, bool_x<FR>>;
+    template <typename FR> using MerkleAuthPath_MiMC = MerkleAuthPath<MiMC<FR>, bool_x<FR>>;
+
+    template <typename FR> using MerkleMultiPath_SHA256 = MerkleMultiPath<SHA256<FR>, bool_x<FR>>;
+    template <typename FR> using MerkleMultiPath_SHA512 = MerkleMultiPath<SHA512<FR>, bool_x<FR>>;
+    template <typename FR> using MerkleMultiPath_MiMC = MerkleMultiPath<MiMC<FR>, bool_x<FR>>;
+} // namespace zk
+
+namespace eval {
+    typedef MerkleAuthPath<SHA256, int> MerkleAuthPath_SHA256;
+    typedef MerkleAuthPath<SHA512, int> MerkleAuthPath_SHA512;
+    template <typename FR> using MerkleAuthPath_MiMC = MerkleAuthPath<MiMC<FR>, int>;
+
+    typedef MerkleMultiPath<SHA256, int> MerkleMultiPath_SHA256;
+    typedef MerkleMultiPath<SHA512, int> MerkleMultiPath_SHA512;
+    template <typename FR> using MerkleMultiPath_MiMC = MerkleMultiPath<MiMC<FR>, int>;
+} // namespace eval
 
 typedef MerkleTree<eval::SHA256> MerkleTree_SHA256;
 typedef MerkleTree<eval::SHA512> MerkleTree_SHA512;
+template <typename FR> using MerkleTree_MiMC = MerkleTree<eval::MiMC<FR>>;
+
+typedef MerkleStore<eval::SHA256> MerkleStore_SHA256;
+typedef MerkleStore<eval::SHA512> MerkleStore_SHA512;
+template <typename FR> using MerkleStore_MiMC = MerkleStore<eval::MiMC<FR>>;
+
+typedef MerkleSparseTree<eval::SHA256> MerkleSparseTree_SHA256;
+typedef MerkleSparseTree<eval::SHA512> MerkleSparseTree_SHA512;
+template <typename FR> using MerkleSparseTree_MiMC = MerkleSparseTree<eval::MiMC<FR>>;
 
 template <typename COUNT> using
-MerkleBundle_SHA256 = MerkleBundle<MerkleTree_SHA256, eval::MerkleAuthPath_SHA256, COUNT>;
+MerkleBundle_SHA256 = MerkleBundle<MerkleStore_SHA256, eval::MerkleAuthPath_SHA256, COUNT>;
 
 template <typename COUNT> using
-MerkleBundle_SHA512 = MerkleBundle<MerkleTree_SHA512, eval::MerkleAuthPath_SHA512, COUNT>;
+MerkleBundle_SHA512 = MerkleBundle<MerkleStore_SHA512, eval::MerkleAuthPath_SHA512, COUNT>;
+
+template <typename FR, typename COUNT> using
+MerkleBundle_MiMC = MerkleBundle<MerkleStore_MiMC<FR>, eval::MerkleAuthPath_MiMC<FR>, COUNT>;
 
 } // namespace snarkfront
 
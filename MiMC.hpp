@@ -0,0 +1,153 @@
+#ifndef _SNARKFRONT_MIMC_HPP_
+#define _SNARKFRONT_MIMC_HPP_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "DSL_base.hpp"
+#include "PowersOf2.hpp"
+#include "SHA_256.hpp"
+#include "TLsingleton.hpp"
+
+namespace snarkfront {
+
+////////////////////////////////////////////////////////////////////////////////
+// MiMC round constants
+//
+// The first round constant is zero. The others are SHA-256 digests of
+// "MiMC" and the round number, reduced into the scalar field.
+//
+
+template <typename FR>
+class MiMC_Constants
+{
+public:
+    // enough rounds for a 254-bit field with exponent 11 (log_11 r)
+    static std::size_t rounds() {
+        return 74;
+    }
+
+    MiMC_Constants() {
+        auto& POW2 = TL<PowersOf2<FR>>::singleton();
+
+        m_C.reserve(rounds());
+        m_C.emplace_back(FR::zero());
+
+        for (std::size_t i = 1; i < rounds(); ++i) {
+            const auto a = digest(eval::SHA256(), "MiMC" + std::to_string(i));
+
+            // digest words are big-endian, bit j has value 2^j
+            std::vector<int> bits;
+            bits.reserve(256);
+            for (std::size_t j = 0; j < 256; ++j)
+                bits.push_back((a[7 - j / 32] >> (j % 32)) & 1);
+
+            m_C.emplace_back(POW2->getNumber(bits));
+        }
+    }
+
+    static const std::vector<FR>& values() {
+        return TL<MiMC_Constants>::singleton()->m_C;
+    }
+
+private:
+    std::vector<FR> m_C;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// MiMC hash of field elements
+//
+// Each round of the block cipher adds the key and round constant then
+// raises to the power 11, a permutation of the scalar field when
+// gcd(11, r - 1) is 1 (true for BN128 and Edwards). The hash is
+// Miyaguchi-Preneel with one field element per message block, so a
+// binary Merkle tree node costs two cipher calls.
+//
+
+template <typename T, typename FR>
+class MiMC_Hash
+{
+public:
+    typedef T WordType;
+    typedef std::array<T, 1> MsgType;
+    typedef std::array<T, 1> DigType;
+
+    MiMC_Hash()
+        : m_C(MiMC_Constants<FR>::values())
+    {}
+
+    const DigType& digest() const {
+        return m_H;
+    }
+
+    // append field element to message
+    void msgInput(const T& a) {
+        m_message.emplace_back(a);
+    }
+
+    // append array of field elements to message
+    template <std::size_t N>
+    void msgInput(const std::array<T, N>& a) {
+        for (const auto& b : a)
+            msgInput(b);
+    }
+
+    void clearMessage() {
+        m_message.clear();
+    }
+
+    void computeHash() {
+        // initial hash value is zero
+        m_H[0] = FR::zero();
+
+        for (const auto& m : m_message) {
+            const T e = encrypt(m_H[0], m);
+            m_H[0] = e + m_H[0] + m;
+        }
+    }
+
+private:
+    // block cipher with key k
+    T encrypt(const T& k, const T& x) const {
+        T a = x;
+
+        for (const auto& c : m_C) {
+            T t, t2, t4, t8;
+            t = a + (k + c);
+            t2 = t * t;
+            t4 = t2 * t2;
+            t8 = t4 * t4;
+            a = t8 * t2 * t;
+        }
+
+        T b;
+        b = a + k;
+        return b;
+    }
+
+    // round constants (shared table, not copied)
+    const std::vector<FR>& m_C;
+
+    // message of field elements
+    std::vector<T> m_message;
+
+    // hash value is one field element
+    DigType m_H;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// typedefs
+//
+
+namespace zk {
+    template <typename FR> using MiMC = MiMC_Hash<fr_x<FR>, FR>;
+} // namespace zk
+
+namespace eval {
+    template <typename FR> using MiMC = MiMC_Hash<FR, FR>;
+} // namespace eval
+
+} // namespace snarkfront
+
+#endif
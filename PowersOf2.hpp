@@ -35,22 +35,69 @@ public:
         return m_lut[index];
     }
 
+    // look up table for bytes, T(digit * 2^(8 * position))
+    const T& lookUpByte(const std::size_t position, const std::uint8_t digit)
+    {
+        // protect against huge index from accidental pointer argument
+#ifdef USE_ASSERT
+        assert(position < 128);
+#endif
+
+        for (std::size_t i = m_byteLut.size(); i <= position; ++i) {
+            const T& a = lookUp(8 * i);
+
+            std::vector<T> v;
+            v.reserve(256);
+            v.emplace_back(T::zero());
+            for (std::size_t j = 1; j < 256; ++j) {
+                // v[j] = j * 2^(8 * i)
+                v.emplace_back(v.back() + a);
+            }
+
+            m_byteLut.emplace_back(v);
+        }
+
+        return m_byteLut[position][digit];
+    }
+
+    // one addition per non-zero byte (no decimal string conversion)
     T getNumber(const std::size_t number) {
         T accum = T::zero();
 
         auto b = number;
         std::size_t i = 0;
         while (b) {
-            if (b & 0x1)
-                accum = accum + lookUp(i);
+            if (b & 0xff)
+                accum = accum + lookUpByte(i, b & 0xff);
 
-            b >>= 1;
+            b >>= 8;
             ++i;
         }
 
         return accum;
     }
 
+    // big integer limbs, one addition per non-zero byte (partial
+    // products and carries of BigInt multiplication)
+    template <mp_size_t N>
+    T getNumber(const snarklib::BigInt<N>& a) {
+        T accum = T::zero();
+
+        for (mp_size_t i = 0; i < N; ++i) {
+            auto b = a.data()[i];
+            std::size_t j = i * sizeof(mp_limb_t);
+            while (b) {
+                if (b & 0xff)
+                    accum = accum + lookUpByte(j, b & 0xff);
+
+                b >>= 8;
+                ++j;
+            }
+        }
+
+        return accum;
+    }
+
     T getNumber(const std::vector<int>& bits) {
         T accum = T::zero();
 
@@ -64,6 +111,7 @@ public:
 
 private:
     std::vector<T> m_lut; // index -> T(2^index)
+    std::vector<std::vector<T>> m_byteLut; // position, digit -> T(digit * 2^(8 * position))
 };
 
 // convert Boolean to BigInt/field/group one and zero
@@ -74,14 +122,26 @@ T boolTo(const bool a) {
 
 // size of type in bits
 std::size_t sizeBits(const bool& dummy);
+std::size_t sizeBits(const std::uint8_t& dummy);
 std::size_t sizeBits(const std::uint32_t& dummy);
 std::size_t sizeBits(const std::uint64_t& dummy);
 
 template <mp_size_t N>
-std::size_t sizeBits(const snarklib::BigInt<N>& dummy) {
+std::size_t sizeBits(const snarklib::BigInt<N>&) {
     return snarklib::BigInt<N>::maxBits();
 }
 
+// number of limbs (scalar terms) of operator results
+template <typename T>
+std::size_t sizeLimbs(const T&) {
+    return 1;
+}
+
+template <mp_size_t N>
+std::size_t sizeLimbs(const snarklib::BigInt<N>&) {
+    return N;
+}
+
 // returns number of matching bits starting from most significant bit
 template <typename BIT>
 int matchMSB(const std::vector<BIT>& a,
@@ -100,6 +160,7 @@ int matchMSB(const std::vector<BIT>& a,
 
 // convert value to bits
 std::vector<int> valueBits(const bool& a);
+std::vector<int> valueBits(const std::uint8_t& a);
 std::vector<int> valueBits(const std::uint32_t& a);
 std::vector<int> valueBits(const std::uint64_t& a);
 
@@ -138,7 +199,7 @@ std::vector<int> bitsValue(UINT_N& a, const std::vector<int>& b)
 // count number of set bits
 std::size_t countBits(const std::vector<int>& v);
 
-// overflow addition (uint32_t and uint64_t)
+// overflow addition (uint8_t, uint32_t and uint64_t)
 template <typename UINT_N>
 void addover(UINT_N& a1, UINT_N& a0, const UINT_N& b) 
 {
@@ -159,13 +220,38 @@ void addover(UINT_N& a1, UINT_N& a0, const UINT_N& b)
 
     const UINT_N lowOriginal = low;
     low += b_bit;
-    if ((0 == low) && (-1 == lowOriginal)) ++high; // handle carry
+    if ((0 == low) && (UINT_N(-1) == lowOriginal)) ++high; // handle carry
 
     // accumulate result
     a1 += high;
     a0 = low;
 }
 
+// overflow multiplication (uint8_t, uint32_t and uint64_t), a1:a0 = a0 * b
+template <typename UINT_N>
+void mulover(UINT_N& a1, UINT_N& a0, const UINT_N& b)
+{
+    // half words
+    const std::size_t H = sizeBits(a0) / 2;
+    const UINT_N
+        mask = (UINT_N(1) << H) - 1,
+        x0 = a0 & mask, x1 = a0 >> H,
+        y0 = b & mask, y1 = b >> H;
+
+    // partial products
+    const UINT_N
+        p00 = x0 * y0,
+        p01 = x0 * y1,
+        p10 = x1 * y0,
+        p11 = x1 * y1;
+
+    // middle half word sum is less than 3 * 2^H
+    const UINT_N mid = (p00 >> H) + (p01 & mask) + (p10 & mask);
+
+    a1 = p11 + (p01 >> H) + (p10 >> H) + (mid >> H);
+    a0 = (mid << H) | (p00 & mask);
+}
+
 } // namespace snarkfront
 
 #endif
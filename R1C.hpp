@@ -1,6 +1,7 @@
 #ifndef _SNARKFRONT_R1C_HPP_
 #define _SNARKFRONT_R1C_HPP_
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <istream>
@@ -129,7 +130,8 @@ public:
     typedef snarklib::R1Term<FR> R1T;
 
     R1C()
-        : m_swap_AB_if_beneficial(false)
+        : m_swap_AB_if_beneficial(false),
+          m_inputDone(false)
     {}
 
     void reset() {
@@ -146,18 +148,26 @@ public:
 
         // input witness for (de)marshalling
         m_input.clear();
+        m_inputDone = false;
     }
 
     std::size_t counterID() const {
         return m_counter.peekID();
     }
 
+    std::size_t constraintCount() const {
+        return m_constraintSystem.constraints().size();
+    }
+
     // mark end of public circuit inputs known to prover and verifier
     void checkpointInput() {
         // assumes all inputs are first
         m_input.checkpoint(
             m_witness_FR,
             m_witness_str);
+
+        m_witness_str.clear();
+        m_inputDone = true;
     }
 
     const R1Cowitness<FR>& input() const {
@@ -230,13 +240,35 @@ public:
         return createTerm(a, false);
     }
 
+    // The field witness of the terms is assigned by createTerm(). Values
+    // are only printed for the public input cowitness, the verifier reads
+    // them back. After the inputs there is no string.
     template <typename VAL>
     void witnessTerms(const std::vector<R1T>& r1Terms, const VAL& value) {
+        if (m_inputDone) return;
+
         std::stringstream ss;
         ss << value;
         addWitness(r1Terms, ss.str());
     }
 
+    // machine integers do not need a stream
+    void witnessTerms(const std::vector<R1T>& r1Terms, const bool value) {
+        if (! m_inputDone) addWitness(r1Terms, value ? "1" : "0");
+    }
+
+    void witnessTerms(const std::vector<R1T>& r1Terms, const std::uint8_t value) {
+        if (! m_inputDone) addWitness(r1Terms, std::to_string(value));
+    }
+
+    void witnessTerms(const std::vector<R1T>& r1Terms, const std::uint32_t value) {
+        if (! m_inputDone) addWitness(r1Terms, std::to_string(value));
+    }
+
+    void witnessTerms(const std::vector<R1T>& r1Terms, const std::uint64_t value) {
+        if (! m_inputDone) addWitness(r1Terms, std::to_string(value));
+    }
+
     void addBooleanity(const R1T& x) {
         rank1_booleanity(m_constraintSystem, x);
     }
@@ -308,22 +340,60 @@ public:
             : arg.r1Terms()[0];
     }
 
-    // argument as bit representation, converts scalar as necessary
+    // argument as bit representation, converts scalar or limbs as necessary
     template <typename ALG>
     std::vector<R1T> argBits(const ALG& arg) {
-        const std::size_t termCnt = arg.r1Terms().size();
+        const std::vector<R1T>& terms = arg.r1Terms();
+        const std::vector<int>& split = arg.splitBits();
 
         typename ALG::ValueType dummy;
+        const std::size_t
+            typeBits = sizeBits(dummy),
+            typeLimbs = sizeLimbs(dummy);
+
+        if (terms.size() == split.size()) {
+            // bits, a range checked BigInt has fewer than the type so
+            // zero extend
 #ifdef USE_ASSERT
-        assert(sizeBits(dummy) == termCnt || 1 == termCnt);
+            assert(terms.size() <= typeBits);
 #endif
 
-        // For uint32/64, sizeBits(dummy) is greater than 1 so the
-        // conditional is equivalent to: 1 == termCnt. This will be
-        // true only for ADDMOD.
-        return ((1 == termCnt) && (sizeBits(dummy) != termCnt))
-            ? witnessToBits(arg.r1Terms()[0], arg.splitBits())
-            : arg.r1Terms();
+            std::vector<R1T> v(terms);
+            while (v.size() < typeBits)
+                v.emplace_back(createConstant(FR::zero()));
+
+            return v;
+        }
+
+        // otherwise one scalar for each limb
+#ifdef USE_ASSERT
+        assert(typeLimbs == terms.size());
+#endif
+
+        if (1 == typeLimbs) {
+            // ADDMOD and MULMOD results have split bits above the word
+            return witnessToBits(terms[0], split);
+        }
+
+        // BigInt limbs, each limb has the same number of bits
+#ifdef USE_ASSERT
+        assert(typeBits == split.size());
+#endif
+
+        const std::size_t limbBits = typeBits / typeLimbs;
+
+        std::vector<R1T> v;
+        v.reserve(typeBits);
+
+        for (std::size_t i = 0; i < typeLimbs; ++i) {
+            const std::vector<int> limbSplit(split.begin() + limbBits * i,
+                                             split.begin() + limbBits * (i + 1));
+
+            for (const auto& b : witnessToBits(terms[i], limbSplit))
+                v.emplace_back(b);
+        }
+
+        return v;
     }
 
     // create constant or variable for operation result
@@ -376,6 +446,91 @@ public:
         }
     }
 
+    // create constant or variable for linear combination result
+    // z = a[0] * x[0] + a[1] * x[1] +...+ a[N-1] * x[N-1]
+    R1T linearResult(const std::vector<R1T>& x,
+                     const std::vector<FR>& a,
+                     const FR& witness)
+    {
+        bool isVar = false;
+        for (const auto& t : x) {
+            if (t.isVariable())
+                isVar = true;
+        }
+
+        const R1T z = createTerm(witness, isVar);
+
+        if (isVar) {
+            rank1_lincomb(m_constraintSystem, x, a, z);
+        }
+
+        return z;
+    }
+
+    // x >= y for unsigned integer bit representations of n bits
+    // (bit n of 2^n + x - y is set if and only if x >= y, dbits are
+    // the n + 1 bits of 2^n + x - y)
+    R1T greaterEqualBits(const std::vector<R1T>& x,
+                         const std::vector<R1T>& y,
+                         const std::vector<int>& dbits)
+    {
+        auto& POW2 = TL<PowersOf2<FR>>::singleton();
+        const std::size_t n = dbits.size() - 1;
+
+        std::vector<R1T> terms;
+        std::vector<FR> coeffs;
+        terms.reserve(2 * n + 1);
+        coeffs.reserve(2 * n + 1);
+
+        terms.emplace_back(createConstant(POW2->lookUp(n)));
+        coeffs.emplace_back(FR::one());
+
+        for (std::size_t i = 0; i < std::min(n, x.size()); ++i) {
+            terms.emplace_back(x[i]);
+            coeffs.emplace_back(POW2->lookUp(i));
+        }
+
+        for (std::size_t i = 0; i < std::min(n, y.size()); ++i) {
+            terms.emplace_back(y[i]);
+            coeffs.emplace_back(FR::zero() - POW2->lookUp(i));
+        }
+
+        const R1T d = linearResult(terms, coeffs, POW2->getNumber(dbits));
+
+        return witnessToBits(d, dbits)[n];
+    }
+
+    // x * (y[0] + y[1] +...+ y[N-1]) == 0
+    void addZeroProduct(const R1T& x, const std::vector<R1T>& y) {
+        bool isVar = x.isVariable();
+        for (const auto& t : y) {
+            if (t.isVariable())
+                isVar = true;
+        }
+
+        if (isVar) {
+            rank1_zeroproduct(m_constraintSystem, x, y);
+        }
+    }
+
+    // create constant or variable for conditional result, z = b ? y : x
+    // (if b, x, y are bits then so is z, no booleanity constraint needed)
+    R1T selectResult(const R1T& b, const R1T& x, const R1T& y, const FR& witness) {
+        if (! b.isVariable()) {
+            // condition is constant
+            return b.zeroTerm() ? x : y;
+
+        } else if (x.zeroTerm() && y.zeroTerm()) {
+            // both choices are null, nothing to select
+            return x;
+
+        } else {
+            const R1T z = createVariable(witness);
+            rank1_select(m_constraintSystem, b, x, y, z);
+            return z;
+        }
+    }
+
     // shift and rotate
     std::vector<R1T> permuteBits(const BitwiseOps op,
                                  const std::vector<R1T>& x,
@@ -388,6 +543,7 @@ public:
         case (BitwiseOps::SHR) : rank1_shiftright(z, n); break;
         case (BitwiseOps::ROTL) : rank1_rotateleft(z, n); break;
         case (BitwiseOps::ROTR) : rank1_rotateright(z, n); break;
+        case (BitwiseOps::MULMOD) : break; // not a shift or rotate
         }
 
         return z;
@@ -521,6 +677,52 @@ public:
         }
     }
 
+    // z = (x == y) or z = (x != y) for field scalars
+    // (difference is invertible if and only if not equal)
+    R1T scalarEquality(const ScalarCmp op,
+                       const R1T& x,
+                       const R1T& y,
+                       const FR& xy_witness,
+                       const bool zbit)
+    {
+#ifdef USE_ASSERT
+        assert(ScalarCmp::EQ == op || ScalarCmp::NEQ == op);
+#endif
+
+        if (! x.isVariable() && ! y.isVariable()) {
+            // x and y are constant
+            return createConstant(boolTo<FR>(zbit));
+        }
+
+        // INV = inverse(x - y) or 0 if x == y
+        const bool same = (FR::zero() == xy_witness);
+        const auto INV = createVariable(same ? FR::zero() : inverse(xy_witness));
+
+        // z is result
+        const auto z = createVariable(boolTo<FR>(zbit));
+
+        if (ScalarCmp::EQ == op) {
+            // (x - y) * z == 0
+            m_constraintSystem.addConstraint(
+                (x - y) * z == FR::zero());
+
+            // (x - y) * INV == 1 - z
+            m_constraintSystem.addConstraint(
+                (x - y) * INV == FR::one() - z);
+
+        } else {
+            // (x - y) * (1 - z) == 0
+            m_constraintSystem.addConstraint(
+                (x - y) * (FR::one() - z) == FR::zero());
+
+            // (x - y) * INV == z
+            m_constraintSystem.addConstraint(
+                (x - y) * INV == z);
+        }
+
+        return z;
+    }
+
 private:
     R1T createVariable(const FR& a) {
         return createTerm(a, true);
@@ -596,6 +798,10 @@ private:
         case (ScalarOps::MUL) :
             rank1_op<R1_MUL<FR>>(m_constraintSystem, x, y, z);
             break;
+
+        case (ScalarOps::DIV) :
+            rank1_op<R1_DIV<FR>>(m_constraintSystem, x, y, z);
+            break;
         }
     }
 
@@ -629,6 +835,10 @@ private:
         case (BitwiseOps::ADDMOD) :
             rank1_op<R1_ADD<FR>>(m_constraintSystem, x, y, z);
             break;
+
+        case (BitwiseOps::MULMOD) :
+            rank1_op<R1_MUL<FR>>(m_constraintSystem, x, y, z);
+            break;
         }
     }
 
@@ -661,6 +871,10 @@ private:
         case (BitwiseOps::ADDMOD) :
             // x + 0 == x
             return x;
+
+        case (BitwiseOps::MULMOD) :
+            // x * 0 == 0
+            return R1T();
         }
     }
 
@@ -686,6 +900,9 @@ private:
 
     // input witness for (de)marshalling
     R1Cowitness<FR> m_input;
+
+    // public inputs are checkpointed, no more cowitness strings
+    bool m_inputDone;
 };
 
 } // namespace snarkfront
@@ -66,6 +66,48 @@ void rank1_split(snarklib::R1System<FR>& S,
     S.addConstraint(LC == x);
 }
 
+// constrain linear combination a[0] * x[0] +...+ a[N-1] * x[N-1] == z
+template <typename FR>
+void rank1_lincomb(snarklib::R1System<FR>& S,
+                   const std::vector<snarklib::R1Term<FR>>& x,
+                   const std::vector<FR>& a,
+                   const snarklib::R1Term<FR>& z)
+{
+#ifdef USE_ASSERT
+    assert(x.size() == a.size());
+    assert(z.isVariable());
+#endif
+
+    snarklib::R1Combination<FR> LC;
+    LC.reserveTerms(x.size());
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        if (! x[i].zeroTerm())
+            LC.addTerm(a[i] * x[i]);
+    }
+
+    S.addConstraint(LC == z);
+}
+
+// constrain x * (y[0] +...+ y[N-1]) == 0
+// (for values which can not wrap around the field modulus, either x
+// is zero or all y[i] are zero)
+template <typename FR>
+void rank1_zeroproduct(snarklib::R1System<FR>& S,
+                       const snarklib::R1Term<FR>& x,
+                       const std::vector<snarklib::R1Term<FR>>& y)
+{
+    snarklib::R1Combination<FR> LC;
+    LC.reserveTerms(y.size());
+
+    for (const auto& a : y) {
+        if (! a.zeroTerm())
+            LC.addTerm(a);
+    }
+
+    S.addConstraint(LC * x == FR::zero());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // operators
 //
@@ -91,10 +133,11 @@ DEFN_R1OP(XOR, x + y - z == ((FR::one() + FR::one()) * x) * y)
 DEFN_R1OP(SAME, x + y + z - FR::one() == ((FR::one() + FR::one()) * x) * y)
 DEFN_R1OP(CMPLMNT, x + z == FR::one())
 
-// ADD, SUB, MUL
+// ADD, SUB, MUL, DIV
 DEFN_R1OP(ADD, x + y == z)
 DEFN_R1OP(SUB, x - y == z)
 DEFN_R1OP(MUL, x * y == z)
+DEFN_R1OP(DIV, z * y == x)
 
 #undef DEFN_R1OP
 
@@ -112,6 +155,21 @@ void rank1_op(
     S.addConstraint(R1OP::constraint(x, y, z));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// conditional select
+//
+
+// z = b ? y : x
+template <typename FR>
+void rank1_select(snarklib::R1System<FR>& S,
+                  const snarklib::R1Term<FR>& b,
+                  const snarklib::R1Term<FR>& x,
+                  const snarklib::R1Term<FR>& y,
+                  const snarklib::R1Term<FR>& z)
+{
+    S.addConstraint((y - x) * b == z - x); // x + b * (y - x) == z
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // bit shift and rotate
 //
@@ -12,6 +12,43 @@
 
 namespace snarkfront {
 
+////////////////////////////////////////////////////////////////////////////////
+// SHA-1 constant values
+//
+
+class SHA_1_K
+{
+public:
+    // constants (NIST FIPS 180-4 section 4.2.1)
+    static constexpr std::uint32_t value(const std::size_t i) {
+        return
+            i < 20 ? 0x5a827999 :
+            i < 40 ? 0x6ed9eba1 :
+            i < 60 ? 0x8f1bbcdc :
+            0xca62c1d6;
+    }
+
+    static std::array<std::uint32_t, 80> values() {
+        std::array<std::uint32_t, 80> a;
+
+        for (std::size_t i = 0; i < 80; ++i) {
+            a[i] = value(i);
+        }
+
+        return a;
+    }
+};
+
+class SHA_1_H
+{
+public:
+    // initial hash value (NIST FIPS 180-4 section 5.3.1)
+    static constexpr std::array<std::uint32_t, 5> values() {
+        return {
+            0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // SHA-1
 //
@@ -25,23 +62,32 @@ public:
     typedef T WordType;
     typedef std::array<T, 16> MsgType;
     typedef std::array<T, 5> DigType;
+    typedef std::array<T, 5> MidType;
+    typedef std::uint32_t ValueType; // word value (eval and zk)
 
-    SHA_1() {
-        initConstants();
-    }
+    SHA_1()
+        : m_K(SHA_Constants<T, F, SHA_1_K>::words())
+    {}
 
     const std::array<T, 5>& digest() const {
         return m_H;
     }
 
+    // intermediate hash value (state after each message block)
+    std::array<T, 5>& hashValue() {
+        return m_H;
+    }
+
+    // append constant word to message (padding and public words)
+    void msgConstant(const std::uint32_t a) {
+        T w;
+        w = F::constant(a);
+        this->msgInput(w);
+    }
+
     void initHashValue() {
         // set initial hash value (NIST FIPS 180-4 section 5.3.1)
-        const std::array<std::uint32_t, 5> a {
-            0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
-
-        for (std::size_t i = 0; i < 5; ++i) {
-            m_H[i] = F::constant(a[i]);
-        }
+        m_H = SHA_Constants<T, F, SHA_1_H>::words();
     }
 
     void prepMsgSchedule(std::size_t& msgIndex) {
@@ -109,25 +155,11 @@ public:
     }
 
 private:
-    void initConstants() {
-        // set constants (NIST FIPS 180-4 section 4.2.1)
-        for (std::size_t i = 0; i < 80; ++i) {
-            if (i < 20)
-                m_K[i] = F::constant(0x5a827999);
-            else if (i < 40)
-                m_K[i] = F::constant(0x6ed9eba1);
-            else if (i < 60)
-                m_K[i] = F::constant(0x8f1bbcdc);
-            else
-                m_K[i] = F::constant(0xca62c1d6);
-        }
-    }
-
     // five 32-bit working variables
     T m_a, m_b, m_c, m_d, m_e;
 
-    // 80 constant 32-bit words
-    std::array<T, 80> m_K;
+    // 80 constant 32-bit words (shared table, not copied)
+    const std::array<T, 80>& m_K;
 
     // message schedule of 80 32-bit words
     std::array<T, 80> m_W;
@@ -12,6 +12,21 @@
 
 namespace snarkfront {
 
+////////////////////////////////////////////////////////////////////////////////
+// SHA-224 constant values
+//
+
+class SHA_224_H
+{
+public:
+    // initial hash value (NIST FIPS 180-4 section 5.3.2)
+    static constexpr std::array<std::uint32_t, 8> values() {
+        return {
+            0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
+            0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4 };
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // SHA-224
 //
@@ -44,13 +59,7 @@ public:
     // overrides base class SHA-256
     virtual void initHashValue() {
         // set initial hash value (NIST FIPS 180-4 section 5.3.2)
-        const std::array<std::uint32_t, 8> a {
-            0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
-            0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4 };
-
-        for (std::size_t i = 0; i < 8; ++i) {
-            this->m_H[i] = F::constant(a[i]);
-        }
+        this->m_H = SHA_Constants<T, F, SHA_224_H>::words();
     }
 
     virtual void afterHash() {
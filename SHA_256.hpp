@@ -9,9 +9,57 @@
 #include "BitwiseOps.hpp"
 #include "Lazy.hpp"
 #include "SecureHashStd.hpp"
+#include "SHA_Native.hpp"
 
 namespace snarkfront {
 
+////////////////////////////////////////////////////////////////////////////////
+// SHA-256 constant values
+//
+
+class SHA_256_K
+{
+public:
+    // constants (NIST FIPS 180-4 section 4.2.2)
+    static constexpr std::array<std::uint32_t, 64> values() {
+        return {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+            0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+            0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+            0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+            0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+            0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+            0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+            0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+            0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+    }
+};
+
+class SHA_256_H
+{
+public:
+    // initial hash value (NIST FIPS 180-4 section 5.3.3)
+    static constexpr std::array<std::uint32_t, 8> values() {
+        return {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // SHA-256
 //
@@ -21,28 +69,39 @@ class SHA_256 : public SHA_Base<SHA_256<T, MSG, F>,
                                 SHA_BlockSize::BLOCK_512,
                                 MSG>
 {
+    typedef SHA_Base<SHA_256<T, MSG, F>, SHA_BlockSize::BLOCK_512, MSG> Base;
+    friend Base;
+
 public:
     typedef T WordType;
     typedef std::array<T, 16> MsgType;
     typedef std::array<T, 8> DigType;
+    typedef std::array<T, 8> MidType;
+    typedef std::uint32_t ValueType; // word value (eval and zk)
 
-    SHA_256() {
-        initConstants();
-    }
+    SHA_256()
+        : m_K(SHA_Constants<T, F, SHA_256_K>::words())
+    {}
 
     const std::array<T, 8>& digest() const {
         return m_H;
     }
 
+    // intermediate hash value (state after each message block)
+    std::array<T, 8>& hashValue() {
+        return m_H;
+    }
+
+    // append constant word to message (padding and public words)
+    void msgConstant(const std::uint32_t a) {
+        T w;
+        w = F::constant(a);
+        this->msgInput(w);
+    }
+
     virtual void initHashValue() {
         // set initial hash value (NIST FIPS 180-4 section 5.3.3)
-        const std::array<std::uint32_t, 8> a {
-            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
-
-        for (std::size_t i = 0; i < 8; ++i) {
-            m_H[i] = F::constant(a[i]);
-        }
+        m_H = SHA_Constants<T, F, SHA_256_H>::words();
     }
 
     void prepMsgSchedule(std::size_t& msgIndex) {
@@ -125,43 +184,20 @@ public:
     }
 
 protected:
-    void initConstants() {
-        // set constants (NIST FIPS 180-4 section 4.2.2)
-        const std::array<std::uint32_t, 64> a {
-            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
-            0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-
-            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
-            0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-
-            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
-            0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-
-            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
-            0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-
-            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
-            0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-
-            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
-            0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-
-            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
-            0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-
-            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
-            0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
-
-        for (std::size_t i = 0; i < 64; ++i) {
-            m_K[i] = F::constant(a[i]);
+    // overrides base class, x86 SHA extensions for 32-bit words (eval)
+    void compressBlock(std::size_t& msgIndex) {
+        if (SHA256_compress(m_H, this->msgBlock(msgIndex))) {
+            msgIndex += 16;
+        } else {
+            Base::compressBlock(msgIndex);
         }
     }
 
     // eight 32-bit working variables
     T m_a, m_b, m_c, m_d, m_e, m_f, m_g, m_h;
 
-    // 64 constant 32-bit words
-    std::array<T, 64> m_K;
+    // 64 constant 32-bit words (shared table, not copied)
+    const std::array<T, 64>& m_K;
 
     // message schedule of 64 32-bit words
     std::array<T, 64> m_W;
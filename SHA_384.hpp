@@ -12,6 +12,24 @@
 
 namespace snarkfront {
 
+////////////////////////////////////////////////////////////////////////////////
+// SHA-384 constant values
+//
+
+class SHA_384_H
+{
+public:
+    // initial hash value (NIST FIPS 180-4 section 5.3.4)
+    static constexpr std::array<std::uint64_t, 8> values() {
+        return {
+            0xcbbb9d5dc1059ed8, 0x629a292a367cd507,
+            0x9159015a3070dd17, 0x152fecd8f70e5939,
+
+            0x67332667ffc00b31, 0x8eb44a8768581511,
+            0xdb0c2e0d64f98fa7, 0x47b5481dbefa4fa4 };
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // SHA-384
 //
@@ -44,16 +62,7 @@ public:
     // overrides base class SHA-512
     virtual void initHashValue() {
         // set initial hash value (NIST FIPS 180-4 section 5.3.4)
-        const std::array<uint64_t, 8> a {
-            0xcbbb9d5dc1059ed8, 0x629a292a367cd507,
-            0x9159015a3070dd17, 0x152fecd8f70e5939,
-
-            0x67332667ffc00b31, 0x8eb44a8768581511,
-            0xdb0c2e0d64f98fa7, 0x47b5481dbefa4fa4 };
-
-        for (std::size_t i = 0; i < 8; ++i) {
-            this->m_H[i] = F::constant(a[i]);
-        }
+        this->m_H = SHA_Constants<T, F, SHA_384_H>::words();
     }
 
     virtual void afterHash() {
@@ -12,6 +12,24 @@
 
 namespace snarkfront {
 
+////////////////////////////////////////////////////////////////////////////////
+// SHA-512/224 constant values
+//
+
+class SHA_512_224_H
+{
+public:
+    // initial hash value (NIST FIPS 180-4 section 5.3.6.1)
+    static constexpr std::array<std::uint64_t, 8> values() {
+        return {
+            0x8C3D37C819544DA2, 0x73E1996689DCD4D6,
+            0x1DFAB7AE32FF9C82, 0x679DD514582F9FCF,
+
+            0x0F6D2B697BD44DA8, 0x77E36F7304C48942,
+            0x3F9D85A86A1D36C8, 0x1112E6AD91D692A1 };
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // SHA-512/224
 //
@@ -59,16 +77,7 @@ public:
     // overrides base class SHA-512
     virtual void initHashValue() {
         // set initial hash value (NIST FIPS 180-4 section 5.3.6.1)
-        const std::array<std::uint64_t, 8> a {
-            0x8C3D37C819544DA2, 0x73E1996689DCD4D6,
-            0x1DFAB7AE32FF9C82, 0x679DD514582F9FCF,
-
-            0x0F6D2B697BD44DA8, 0x77E36F7304C48942,
-            0x3F9D85A86A1D36C8, 0x1112E6AD91D692A1 };
-
-        for (std::size_t i = 0; i < 8; ++i) {
-            this->m_H[i] = F::constant(a[i]);
-        }
+        this->m_H = SHA_Constants<T, F, SHA_512_224_H>::words();
     }
 
     virtual void afterHash() {
@@ -12,6 +12,24 @@
 
 namespace snarkfront {
 
+////////////////////////////////////////////////////////////////////////////////
+// SHA-512/256 constant values
+//
+
+class SHA_512_256_H
+{
+public:
+    // initial hash value (NIST FIPS 180-4 section 5.3.6.2)
+    static constexpr std::array<std::uint64_t, 8> values() {
+        return {
+            0x22312194FC2BF72C, 0x9F555FA3C84C64C2,
+            0x2393B86B6F53B151, 0x963877195940EABD,
+
+            0x96283EE2A88EFFE3, 0xBE5E1E2553863992,
+            0x2B0199FC2C85B8AA, 0x0EB72DDC81C52CA2 };
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // SHA-512/256
 //
@@ -51,26 +69,17 @@ public:
         return m_Hleft256;
     }
 
-    virtual void afterHash() {
-        m_setDigest = true;
-    }
-
-protected:
     // overrides base class SHA-512
-    void initHashValue() {
+    virtual void initHashValue() {
         // set initial hash value (NIST FIPS 180-4 section 5.3.6.2)
-        const std::array<std::uint64_t, 8> a {
-            0x22312194FC2BF72C, 0x9F555FA3C84C64C2,
-            0x2393B86B6F53B151, 0x963877195940EABD,
-
-            0x96283EE2A88EFFE3, 0xBE5E1E2553863992,
-            0x2B0199FC2C85B8AA, 0x0EB72DDC81C52CA2 };
+        this->m_H = SHA_Constants<T, F, SHA_512_256_H>::words();
+    }
 
-        for (std::size_t i = 0; i < 8; ++i) {
-            this->m_H[i] = F::constant(a[i]);
-        }
+    virtual void afterHash() {
+        m_setDigest = true;
     }
 
+protected:
     // truncated 256-bit message digest
     std::array<H, 8> m_Hleft256;
 
@@ -0,0 +1,527 @@
+#ifndef _SNARKFRONT_SHA_CONSTEXPR_HPP_
+#define _SNARKFRONT_SHA_CONSTEXPR_HPP_
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "BitwiseOps.hpp"
+#include "SecureHashStd.hpp"
+#include "SHA_1.hpp"
+#include "SHA_224.hpp"
+#include "SHA_256.hpp"
+#include "SHA_384.hpp"
+#include "SHA_512.hpp"
+#include "SHA_512_224.hpp"
+#include "SHA_512_256.hpp"
+
+namespace snarkfront {
+
+////////////////////////////////////////////////////////////////////////////////
+// compile-time eval SHA-1 and SHA-2
+//
+// Every function is a single return statement (C++11 constexpr) so
+// digests of literal data are constant expressions. Rounds are template
+// recursion, one function per round with the round constant and
+// schedule index fixed. At runtime this is a straight-line kernel with
+// no virtual calls and no constant tables built on first use. Message
+// words are loaded whole, only the last block(s) branch on padding.
+// Throughput is about the same as digest(), not faster.
+//
+
+// round functions are always inlined (recursion is too deep for the
+// inlining heuristics at -O2)
+#ifdef __GNUC__
+#define SHA_CONSTEXPR_INLINE __attribute__((always_inline))
+#else
+#define SHA_CONSTEXPR_INLINE
+#endif
+
+// index sequence (std::index_sequence is C++14)
+template <std::size_t... I> class SHA_Index {};
+
+template <std::size_t N, std::size_t... I>
+class SHA_MakeIndex : public SHA_MakeIndex<N - 1, N - 1, I...> {};
+
+template <std::size_t... I>
+class SHA_MakeIndex<0, I...>
+{
+public:
+    typedef SHA_Index<I...> type;
+};
+
+// the const overload of std::array::operator[] is constexpr in C++11
+template <typename W, std::size_t N>
+constexpr W SHA_at(const std::array<W, N>& a, const std::size_t i) {
+    return a[i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// word array operations
+//
+
+template <typename W, std::size_t N>
+class SHA_Words
+{
+    typedef typename SHA_MakeIndex<N>::type Index;
+
+public:
+    typedef std::array<W, N> ArrayType;
+
+    // a + b, word by word
+    SHA_CONSTEXPR_INLINE static constexpr ArrayType add(const ArrayType& a, const ArrayType& b) {
+        return add(a, b, Index());
+    }
+
+    // a with word i replaced by x
+    SHA_CONSTEXPR_INLINE static constexpr ArrayType replace(const ArrayType& a,
+                                       const std::size_t i,
+                                       const W x) {
+        return replace(a, i, x, Index());
+    }
+
+private:
+    template <std::size_t... I>
+    SHA_CONSTEXPR_INLINE static constexpr ArrayType add(const ArrayType& a,
+                                   const ArrayType& b,
+                                   SHA_Index<I...>) {
+        return {{ W(a[I] + b[I])... }};
+    }
+
+    template <std::size_t... I>
+    SHA_CONSTEXPR_INLINE static constexpr ArrayType replace(const ArrayType& a,
+                                       const std::size_t i,
+                                       const W x,
+                                       SHA_Index<I...>) {
+        return {{ (I == i ? x : a[I])... }};
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// padded message (NIST FIPS 180-4 section 5.1)
+// (same layout as padWords in SHA_Native.hpp, message length < 2^64 bits)
+//
+
+template <typename W>
+class SHA_PaddedMsg
+{
+    typedef typename SHA_MakeIndex<16>::type Index;
+
+public:
+    typedef std::array<W, 16> BlockType;
+
+    static constexpr std::size_t wordBytes() {
+        return sizeof(W);
+    }
+
+    static constexpr std::size_t blockBytes() {
+        return 16 * wordBytes();
+    }
+
+    // message, bit "1", zeros, message length (two words)
+    static constexpr std::size_t paddedBytes(const std::size_t len) {
+        return (len + 1 + 2 * wordBytes() + blockBytes() - 1)
+            / blockBytes() * blockBytes();
+    }
+
+    static constexpr std::size_t numBlocks(const std::size_t len) {
+        return paddedBytes(len) / blockBytes();
+    }
+
+    // big-endian word j of padded message, words of message bytes are
+    // loaded whole, only the word with the end of the message and the
+    // length words are padding
+    SHA_CONSTEXPR_INLINE static constexpr W word(const char* s,
+                                                 const std::size_t len,
+                                                 const std::size_t j) {
+        return
+            (j + 1) * wordBytes() <= len ? load(s + j * wordBytes()) :
+            j * wordBytes() <= len ? endWord(s, len, j * wordBytes()) :
+            (j + 1) * wordBytes() == paddedBytes(len) ? W(8 * std::uint64_t(len)) :
+            (j + 2) * wordBytes() == paddedBytes(len) && 4 == wordBytes()
+                ? W((8 * std::uint64_t(len)) >> 32) :
+            W(0);
+    }
+
+    // message block b
+    SHA_CONSTEXPR_INLINE static constexpr BlockType block(const char* s,
+                                     const std::size_t len,
+                                     const std::size_t b) {
+        return block(s, len, b, Index());
+    }
+
+private:
+    SHA_CONSTEXPR_INLINE static constexpr std::uint64_t u8(const char c) {
+        return static_cast<std::uint8_t>(c);
+    }
+
+    // big-endian word of message bytes
+    SHA_CONSTEXPR_INLINE static constexpr W load(const char* p) {
+        return 4 == wordBytes()
+            ? W(u8(p[0]) << 24 | u8(p[1]) << 16 | u8(p[2]) << 8 | u8(p[3]))
+            : W(u8(p[0]) << 56 | u8(p[1]) << 48 | u8(p[2]) << 40 | u8(p[3]) << 32
+                | u8(p[4]) << 24 | u8(p[5]) << 16 | u8(p[6]) << 8 | u8(p[7]));
+    }
+
+    // word starting at byte i with the last message bytes, the "1" bit
+    // and zeros
+    static constexpr W endWord(const char* s,
+                               const std::size_t len,
+                               const std::size_t i,
+                               const std::size_t n = sizeof(W)) {
+        return 0 == n
+            ? W(0)
+            : W(endWord(s, len, i, n - 1) << 8)
+                | (i + n - 1 < len ? W(u8(s[i + n - 1])) :
+                   i + n - 1 == len ? W(0x80) :
+                   W(0));
+    }
+
+    template <std::size_t... I>
+    SHA_CONSTEXPR_INLINE static constexpr BlockType block(const char* s,
+                                     const std::size_t len,
+                                     const std::size_t b,
+                                     SHA_Index<I...>) {
+        return {{ word(s, len, 16 * b + I)... }};
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// SHA-2 parameters by word size
+//
+
+template <typename W> class SHA2_ConstexprParams;
+
+template <>
+class SHA2_ConstexprParams<std::uint32_t>
+{
+    typedef SHA_Functions<std::uint32_t,
+                          std::uint32_t,
+                          BitwiseINT<std::uint32_t, std::uint32_t>> F;
+
+public:
+    static constexpr std::size_t rounds() { return 64; }
+
+    static constexpr std::uint32_t K(const std::size_t i) {
+        return SHA_at(SHA_256_K::values(), i);
+    }
+
+    static constexpr std::uint32_t SIGMA_0(const std::uint32_t x) { return F::SIGMA_256_0(x); }
+    static constexpr std::uint32_t SIGMA_1(const std::uint32_t x) { return F::SIGMA_256_1(x); }
+    static constexpr std::uint32_t sigma_0(const std::uint32_t x) { return F::sigma_256_0(x); }
+    static constexpr std::uint32_t sigma_1(const std::uint32_t x) { return F::sigma_256_1(x); }
+};
+
+template <>
+class SHA2_ConstexprParams<std::uint64_t>
+{
+    typedef SHA_Functions<std::uint64_t,
+                          std::uint64_t,
+                          BitwiseINT<std::uint64_t, std::uint64_t>> F;
+
+public:
+    static constexpr std::size_t rounds() { return 80; }
+
+    static constexpr std::uint64_t K(const std::size_t i) {
+        return SHA_at(SHA_512_K::values(), i);
+    }
+
+    static constexpr std::uint64_t SIGMA_0(const std::uint64_t x) { return F::SIGMA_512_0(x); }
+    static constexpr std::uint64_t SIGMA_1(const std::uint64_t x) { return F::SIGMA_512_1(x); }
+    static constexpr std::uint64_t sigma_0(const std::uint64_t x) { return F::sigma_512_0(x); }
+    static constexpr std::uint64_t sigma_1(const std::uint64_t x) { return F::sigma_512_1(x); }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// SHA-2 compression rounds (NIST FIPS 180-4 sections 6.2.2, 6.4.2)
+//
+// The message schedule is a window of the last 16 words. Round R
+// replaces word R mod 16 (which is W[R-16]) with W[R].
+//
+
+template <typename W,
+          std::size_t R = 0,
+          bool DONE = (SHA2_ConstexprParams<W>::rounds() == R)>
+class SHA2_Rounds
+{
+    typedef SHA2_ConstexprParams<W> P;
+    typedef SHA_Functions<W, W, BitwiseINT<W, W>> F;
+    typedef SHA_Words<W, 8> S;
+    typedef SHA_Words<W, 16> M;
+
+    // round constant is folded even when the digest is not constant
+    typedef std::integral_constant<W, P::K(R)> KR;
+
+public:
+    SHA_CONSTEXPR_INLINE static constexpr typename S::ArrayType run(const typename S::ArrayType& s,
+                                               const typename M::ArrayType& w) {
+        return step(s,
+                    w,
+                    R < 16
+                        ? w[R % 16]
+                        : W(P::sigma_1(w[(R - 2) % 16]) + w[(R - 7) % 16]
+                            + P::sigma_0(w[(R - 15) % 16]) + w[R % 16]));
+    }
+
+private:
+    SHA_CONSTEXPR_INLINE static constexpr typename S::ArrayType step(const typename S::ArrayType& s,
+                                                const typename M::ArrayType& w,
+                                                const W x) {
+        return next(s, w, x,
+                    W(s[7] + P::SIGMA_1(s[4]) + F::Ch(s[4], s[5], s[6]) + KR::value + x),
+                    W(P::SIGMA_0(s[0]) + F::Maj(s[0], s[1], s[2])));
+    }
+
+    SHA_CONSTEXPR_INLINE static constexpr typename S::ArrayType next(const typename S::ArrayType& s,
+                                                const typename M::ArrayType& w,
+                                                const W x,
+                                                const W T1,
+                                                const W T2) {
+        return SHA2_Rounds<W, R + 1>::run(
+            {{ W(T1 + T2), s[0], s[1], s[2], W(s[3] + T1), s[4], s[5], s[6] }},
+            M::replace(w, R % 16, x));
+    }
+};
+
+template <typename W, std::size_t R>
+class SHA2_Rounds<W, R, true>
+{
+    typedef SHA_Words<W, 8> S;
+    typedef SHA_Words<W, 16> M;
+
+public:
+    SHA_CONSTEXPR_INLINE static constexpr typename S::ArrayType run(const typename S::ArrayType& s,
+                                               const typename M::ArrayType&) {
+        return s;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// SHA-1 compression rounds (NIST FIPS 180-4 section 6.1.2)
+//
+
+template <std::size_t R = 0, bool DONE = (80 == R)>
+class SHA1_Rounds
+{
+    typedef std::uint32_t W;
+    typedef SHA_Functions<W, W, BitwiseINT<W, W>> F;
+    typedef SHA_Words<W, 5> S;
+    typedef SHA_Words<W, 16> M;
+
+    typedef std::integral_constant<W, SHA_1_K::value(R)> KR;
+
+public:
+    SHA_CONSTEXPR_INLINE static constexpr typename S::ArrayType run(const typename S::ArrayType& s,
+                                               const typename M::ArrayType& w) {
+        return next(s,
+                    w,
+                    R < 16
+                        ? w[R % 16]
+                        : F::ROTL(w[(R - 3) % 16] ^ w[(R - 8) % 16]
+                                  ^ w[(R - 14) % 16] ^ w[R % 16], 1));
+    }
+
+private:
+    SHA_CONSTEXPR_INLINE static constexpr typename S::ArrayType next(const typename S::ArrayType& s,
+                                                const typename M::ArrayType& w,
+                                                const W x) {
+        return SHA1_Rounds<R + 1>::run(
+            {{ W(F::ROTL(s[0], 5) + F::f(s[1], s[2], s[3], R) + s[4] + KR::value + x),
+               s[0],
+               F::ROTL(s[1], 30),
+               s[2],
+               s[3] }},
+            M::replace(w, R % 16, x));
+    }
+};
+
+template <std::size_t R>
+class SHA1_Rounds<R, true>
+{
+    typedef SHA_Words<std::uint32_t, 5> S;
+    typedef SHA_Words<std::uint32_t, 16> M;
+
+public:
+    SHA_CONSTEXPR_INLINE static constexpr typename S::ArrayType run(const typename S::ArrayType& s,
+                                               const typename M::ArrayType&) {
+        return s;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// hash value after all blocks of padded message
+//
+
+template <typename W, typename ROUNDS, std::size_t N>
+class SHA_ConstexprHash
+{
+    typedef SHA_Words<W, N> S;
+    typedef SHA_PaddedMsg<W> P;
+
+public:
+    static constexpr typename S::ArrayType hash(const typename S::ArrayType& H,
+                                                const char* s,
+                                                const std::size_t len,
+                                                const std::size_t b = 0) {
+        return P::numBlocks(len) == b
+            ? H
+            : hash(S::add(H, ROUNDS::run(H, P::block(s, len, b))), s, len, b + 1);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// digests by eval hash algorithm
+//
+
+template <typename T> class SHA_Constexpr;
+
+template <>
+class SHA_Constexpr<eval::SHA1>
+{
+public:
+    static constexpr eval::SHA1::DigType digest(const char* s,
+                                                const std::size_t len) {
+        return SHA_ConstexprHash<std::uint32_t, SHA1_Rounds<>, 5>::hash(
+            SHA_1_H::values(), s, len);
+    }
+};
+
+template <>
+class SHA_Constexpr<eval::SHA256>
+{
+public:
+    static constexpr eval::SHA256::DigType digest(const char* s,
+                                                  const std::size_t len) {
+        return SHA_ConstexprHash<std::uint32_t, SHA2_Rounds<std::uint32_t>, 8>::hash(
+            SHA_256_H::values(), s, len);
+    }
+};
+
+template <>
+class SHA_Constexpr<eval::SHA224>
+{
+    typedef std::array<std::uint32_t, 8> H;
+
+public:
+    // leftmost 224 bits
+    static constexpr eval::SHA224::DigType digest(const char* s,
+                                                  const std::size_t len) {
+        return truncate(
+            SHA_ConstexprHash<std::uint32_t, SHA2_Rounds<std::uint32_t>, 8>::hash(
+                SHA_224_H::values(), s, len));
+    }
+
+private:
+    static constexpr eval::SHA224::DigType truncate(const H& a) {
+        return {{ a[0], a[1], a[2], a[3], a[4], a[5], a[6] }};
+    }
+};
+
+template <>
+class SHA_Constexpr<eval::SHA512>
+{
+public:
+    static constexpr eval::SHA512::DigType digest(const char* s,
+                                                  const std::size_t len) {
+        return SHA_ConstexprHash<std::uint64_t, SHA2_Rounds<std::uint64_t>, 8>::hash(
+            SHA_512_H::values(), s, len);
+    }
+};
+
+template <>
+class SHA_Constexpr<eval::SHA384>
+{
+    typedef std::array<std::uint64_t, 8> H;
+
+public:
+    // leftmost 384 bits
+    static constexpr eval::SHA384::DigType digest(const char* s,
+                                                  const std::size_t len) {
+        return truncate(
+            SHA_ConstexprHash<std::uint64_t, SHA2_Rounds<std::uint64_t>, 8>::hash(
+                SHA_384_H::values(), s, len));
+    }
+
+private:
+    static constexpr eval::SHA384::DigType truncate(const H& a) {
+        return {{ a[0], a[1], a[2], a[3], a[4], a[5] }};
+    }
+};
+
+// SHA-512/t digests are 32-bit words, high word of each 64-bit word first
+template <typename T, typename IV, std::size_t N>
+class SHA_Constexpr_512_t
+{
+    typedef std::array<std::uint64_t, 8> H;
+    typedef typename SHA_MakeIndex<N>::type Index;
+
+public:
+    static constexpr typename T::DigType digest(const char* s,
+                                                const std::size_t len) {
+        return split(
+            SHA_ConstexprHash<std::uint64_t, SHA2_Rounds<std::uint64_t>, 8>::hash(
+                IV::values(), s, len),
+            Index());
+    }
+
+private:
+    template <std::size_t... I>
+    static constexpr typename T::DigType split(const H& a, SHA_Index<I...>) {
+        return {{ std::uint32_t(0 == I % 2 ? a[I / 2] >> 32 : a[I / 2])... }};
+    }
+};
+
+template <>
+class SHA_Constexpr<eval::SHA512_224>
+    : public SHA_Constexpr_512_t<eval::SHA512_224, SHA_512_224_H, 7>
+{};
+
+template <>
+class SHA_Constexpr<eval::SHA512_256>
+    : public SHA_Constexpr_512_t<eval::SHA512_256, SHA_512_256_H, 8>
+{};
+
+////////////////////////////////////////////////////////////////////////////////
+// convenient message digest for data
+//
+
+// not a constant expression, so a char array without a null terminator
+// fails to compile in a constant expression (and asserts at runtime)
+inline std::size_t SHA_ConstexprNotLiteral(const std::size_t N) {
+#ifdef USE_ASSERT
+    assert(false);
+#endif
+    return N;
+}
+
+// string literals only, the null terminator is not hashed
+// (use the pointer and length overload for other char arrays)
+template <typename T, std::size_t N>
+constexpr typename T::DigType digest_constexpr(const char (&a)[N]) {
+    return SHA_Constexpr<T>::digest(a, '\0' == a[N - 1]
+                                        ? N - 1
+                                        : SHA_ConstexprNotLiteral(N));
+}
+
+template <typename T>
+constexpr typename T::DigType digest_constexpr(const char* a,
+                                               const std::size_t len) {
+    return SHA_Constexpr<T>::digest(a, len);
+}
+
+template <typename T>
+typename T::DigType digest_constexpr(const std::string& a) {
+    return SHA_Constexpr<T>::digest(a.data(), a.size());
+}
+
+template <typename T>
+typename T::DigType digest_constexpr(const std::vector<std::uint8_t>& a) {
+    return SHA_Constexpr<T>::digest(reinterpret_cast<const char*>(a.data()),
+                                    a.size());
+}
+
+} // namespace snarkfront
+
+#endif
@@ -0,0 +1,422 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include "SHA_256.hpp"
+#include "SHA_512.hpp"
+#include "SHA_Native.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SNARKFRONT_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace snarkfront {
+
+////////////////////////////////////////////////////////////////////////////////
+// x86 SHA extensions (SHA-NI)
+//
+
+#ifdef SNARKFRONT_X86
+
+// CPUID leaf 7 EBX bit 29 is SHA, leaf 1 ECX bit 19 is SSE4.1
+static bool cpuHasSHA_NI() {
+    unsigned int eax, ebx, ecx, edx;
+
+    if (! __get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1))
+        return false;
+
+    if (! __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+
+    return ebx & (1u << 29);
+}
+
+// SHA-256 round constants in 128-bit lanes
+static const array<uint32_t, 64>& roundConstants() {
+    static const array<uint32_t, 64> K = SHA_256_K::values();
+    return K;
+}
+
+// state is ABEF and CDGH in two registers, message words are already
+// host order values (no byte shuffle)
+__attribute__((target("sha,sse4.1")))
+static void compressSHA_NI(array<uint32_t, 8>& H, const uint32_t* W)
+{
+    const uint32_t* K = roundConstants().data();
+
+    __m128i STATE0, STATE1, MSG, TMP, M[4];
+
+    // DCBA, HGFE to ABEF, CDGH
+    TMP = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&H[0]));
+    STATE1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&H[4]));
+    TMP = _mm_shuffle_epi32(TMP, 0xB1);
+    STATE1 = _mm_shuffle_epi32(STATE1, 0x1B);
+    STATE0 = _mm_alignr_epi8(TMP, STATE1, 8);
+    STATE1 = _mm_blend_epi16(STATE1, TMP, 0xF0);
+
+    const __m128i ABEF = STATE0, CDGH = STATE1;
+
+    for (size_t i = 0; i < 4; ++i)
+        M[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(W + 4 * i));
+
+    // sixteen groups of four rounds, message schedule interleaved
+    for (size_t i = 0; i < 16; ++i) {
+        __m128i& Mi = M[i % 4];
+        __m128i& Mprev = M[(i + 3) % 4];
+        __m128i& Mnext = M[(i + 1) % 4];
+
+        MSG = _mm_add_epi32(
+            Mi,
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 4 * i)));
+        STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+
+        if (i >= 3 && i < 15) {
+            TMP = _mm_alignr_epi8(Mi, Mprev, 4);
+            Mnext = _mm_add_epi32(Mnext, TMP);
+            Mnext = _mm_sha256msg2_epu32(Mnext, Mi);
+        }
+
+        MSG = _mm_shuffle_epi32(MSG, 0x0E);
+        STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+
+        if (i >= 1 && i < 13) {
+            Mprev = _mm_sha256msg1_epu32(Mprev, Mi);
+        }
+    }
+
+    STATE0 = _mm_add_epi32(STATE0, ABEF);
+    STATE1 = _mm_add_epi32(STATE1, CDGH);
+
+    // ABEF, CDGH back to DCBA, HGFE
+    TMP = _mm_shuffle_epi32(STATE0, 0x1B);
+    STATE1 = _mm_shuffle_epi32(STATE1, 0xB1);
+    STATE0 = _mm_blend_epi16(TMP, STATE1, 0xF0);
+    STATE1 = _mm_alignr_epi8(STATE1, TMP, 8);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&H[0]), STATE0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&H[4]), STATE1);
+}
+
+#else
+
+static bool cpuHasSHA_NI() {
+    return false;
+}
+
+static void compressSHA_NI(array<uint32_t, 8>&, const uint32_t*) {
+}
+
+#endif
+
+static atomic<bool>& enableSHA_NI() {
+    static atomic<bool> a(cpuHasSHA_NI());
+    return a;
+}
+
+bool SHA_NI_enabled() {
+    return enableSHA_NI();
+}
+
+void SHA_NI_enable(const bool a) {
+    enableSHA_NI() = a && cpuHasSHA_NI();
+}
+
+bool SHA256_compress(array<uint32_t, 8>& H, const uint32_t* W) {
+    if (! SHA_NI_enabled())
+        return false;
+
+    compressSHA_NI(H, W);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// multi-buffer SHA-2
+//
+
+// rounds, constants and rotations (NIST FIPS 180-4 sections 4.1.2, 4.1.3)
+template <typename W> class SHA2_Params;
+
+template <>
+class SHA2_Params<uint32_t>
+{
+public:
+    static const size_t rounds = 64;
+
+    static const uint32_t* K() {
+        static const array<uint32_t, 64> a = SHA_256_K::values();
+        return a.data();
+    }
+
+    static const unsigned int
+        S0a = 2, S0b = 13, S0c = 22,
+        S1a = 6, S1b = 11, S1c = 25,
+        s0a = 7, s0b = 18, s0c = 3,
+        s1a = 17, s1b = 19, s1c = 10;
+};
+
+template <>
+class SHA2_Params<uint64_t>
+{
+public:
+    static const size_t rounds = 80;
+
+    static const uint64_t* K() {
+        static const array<uint64_t, 80> a = SHA_512_K::values();
+        return a.data();
+    }
+
+    static const unsigned int
+        S0a = 28, S0b = 34, S0c = 39,
+        S1a = 14, S1b = 18, S1c = 41,
+        s0a = 1, s0b = 8, s0c = 7,
+        s1a = 19, s1b = 61, s1c = 6;
+};
+
+#ifdef SNARKFRONT_X86
+#define SNARKFRONT_INLINE inline __attribute__((always_inline))
+#else
+#define SNARKFRONT_INLINE inline
+#endif
+
+// one block in every lane, V is a vector of lane words (or one word)
+template <typename W, typename V>
+SNARKFRONT_INLINE
+void compressLanes(V H[8], V M[16])
+{
+    typedef SHA2_Params<W> P;
+    const unsigned int n = sizeof(W) * CHAR_BIT;
+    const W* K = P::K();
+
+#define ROTR(x, c) (((x) >> (c)) | ((x) << (n - (c))))
+
+    V a = H[0], b = H[1], c = H[2], d = H[3],
+      e = H[4], f = H[5], g = H[6], h = H[7];
+
+#ifdef SNARKFRONT_X86
+#pragma GCC unroll 80
+#endif
+    for (size_t t = 0; t < P::rounds; ++t) {
+        // message schedule in circular buffer of 16 words
+        if (t >= 16) {
+            const V
+                w2 = M[(t - 2) % 16],
+                w15 = M[(t - 15) % 16];
+
+            M[t % 16] +=
+                (ROTR(w2, P::s1a) ^ ROTR(w2, P::s1b) ^ (w2 >> P::s1c)) +
+                M[(t - 7) % 16] +
+                (ROTR(w15, P::s0a) ^ ROTR(w15, P::s0b) ^ (w15 >> P::s0c));
+        }
+
+        const V
+            T1 = h +
+                 (ROTR(e, P::S1a) ^ ROTR(e, P::S1b) ^ ROTR(e, P::S1c)) +
+                 ((e & f) ^ (~e & g)) +
+                 K[t] +
+                 M[t % 16],
+            T2 = (ROTR(a, P::S0a) ^ ROTR(a, P::S0b) ^ ROTR(a, P::S0c)) +
+                 ((a & b) ^ (a & c) ^ (b & c));
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + T1;
+        d = c;
+        c = b;
+        b = a;
+        a = T1 + T2;
+    }
+
+#undef ROTR
+
+    H[0] += a;
+    H[1] += b;
+    H[2] += c;
+    H[3] += d;
+    H[4] += e;
+    H[5] += f;
+    H[6] += g;
+    H[7] += h;
+}
+
+// one message at a time (no SIMD)
+template <typename W>
+void compressEach(vector<array<W, 8>>& H, const vector<vector<W>>& msg)
+{
+    for (size_t j = 0; j < msg.size(); ++j) {
+        for (size_t k = 0; k < msg[j].size(); k += 16) {
+            W block[16];
+            for (size_t i = 0; i < 16; ++i)
+                block[i] = msg[j][k + i];
+
+            compressLanes<W>(H[j].data(), block);
+        }
+    }
+}
+
+#ifdef SNARKFRONT_X86
+
+// messages are assigned to lanes as they become free
+template <typename W, size_t L>
+SNARKFRONT_INLINE
+void compressMany(vector<array<W, 8>>& H, const vector<vector<W>>& msg)
+{
+    typedef W V __attribute__((vector_size(sizeof(W) * L)));
+
+    const size_t NONE = -1;
+    array<size_t, L> job, pos;
+    job.fill(NONE);
+    pos.fill(0);
+
+    V state[8], block[16];
+    W words[16][L]; // transposed message blocks
+    size_t next = 0;
+
+    while (true) {
+        bool active = false;
+
+        for (size_t lane = 0; lane < L; ++lane) {
+            // finished message
+            if (NONE != job[lane] && msg[job[lane]].size() == pos[lane]) {
+                for (size_t i = 0; i < 8; ++i)
+                    H[job[lane]][i] = state[i][lane];
+
+                job[lane] = NONE;
+            }
+
+            // next message (an empty message keeps initial hash value)
+            if (NONE == job[lane]) {
+                while (next < msg.size() && msg[next].empty())
+                    ++next;
+
+                if (next < msg.size()) {
+                    job[lane] = next++;
+                    pos[lane] = 0;
+
+                    for (size_t i = 0; i < 8; ++i)
+                        state[i][lane] = H[job[lane]][i];
+                }
+            }
+
+            // message block or idle lane
+            if (NONE != job[lane]) {
+                active = true;
+
+                const W* w = msg[job[lane]].data() + pos[lane];
+                for (size_t i = 0; i < 16; ++i)
+                    words[i][lane] = w[i];
+
+                pos[lane] += 16;
+
+            } else {
+                for (size_t i = 0; i < 16; ++i)
+                    words[i][lane] = 0;
+            }
+        }
+
+        if (! active) break;
+
+        memcpy(block, words, sizeof(block));
+
+        compressLanes<W>(state, block);
+    }
+}
+
+__attribute__((target("avx2")))
+static void compressAVX2(vector<array<uint32_t, 8>>& H,
+                         const vector<vector<uint32_t>>& msg) {
+    compressMany<uint32_t, 8>(H, msg);
+}
+
+__attribute__((target("avx2")))
+static void compressAVX2(vector<array<uint64_t, 8>>& H,
+                         const vector<vector<uint64_t>>& msg) {
+    compressMany<uint64_t, 4>(H, msg);
+}
+
+__attribute__((target("avx512f")))
+static void compressAVX512(vector<array<uint32_t, 8>>& H,
+                           const vector<vector<uint32_t>>& msg) {
+    compressMany<uint32_t, 16>(H, msg);
+}
+
+__attribute__((target("avx512f")))
+static void compressAVX512(vector<array<uint64_t, 8>>& H,
+                           const vector<vector<uint64_t>>& msg) {
+    compressMany<uint64_t, 8>(H, msg);
+}
+
+static SHA_SIMD cpuSIMD() {
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f")) return SHA_SIMD::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SHA_SIMD::AVX2;
+    return SHA_SIMD::NONE;
+}
+
+#else
+
+template <typename W>
+static void compressAVX2(vector<array<W, 8>>& H, const vector<vector<W>>& msg) {
+    compressEach(H, msg);
+}
+
+template <typename W>
+static void compressAVX512(vector<array<W, 8>>& H, const vector<vector<W>>& msg) {
+    compressEach(H, msg);
+}
+
+static SHA_SIMD cpuSIMD() {
+    return SHA_SIMD::NONE;
+}
+
+#endif
+
+static atomic<SHA_SIMD>& enableSIMD() {
+    static atomic<SHA_SIMD> a(cpuSIMD());
+    return a;
+}
+
+SHA_SIMD SHA_SIMD_enabled() {
+    return enableSIMD();
+}
+
+void SHA_SIMD_enable(const SHA_SIMD a) {
+    enableSIMD() = std::min(a, cpuSIMD());
+}
+
+template <typename W>
+static void compressDispatch(vector<array<W, 8>>& H,
+                             const vector<vector<W>>& msg)
+{
+#ifdef USE_ASSERT
+    assert(H.size() == msg.size());
+    for (const auto& m : msg)
+        assert(0 == m.size() % 16);
+#endif
+
+    switch (SHA_SIMD_enabled()) {
+    case (SHA_SIMD::AVX512) : compressAVX512(H, msg); break;
+    case (SHA_SIMD::AVX2) : compressAVX2(H, msg); break;
+    case (SHA_SIMD::NONE) : compressEach(H, msg); break;
+    }
+}
+
+void SHA2_compress_many(vector<array<uint32_t, 8>>& H,
+                        const vector<vector<uint32_t>>& msg)
+{
+    compressDispatch(H, msg);
+}
+
+void SHA2_compress_many(vector<array<uint64_t, 8>>& H,
+                        const vector<vector<uint64_t>>& msg)
+{
+    compressDispatch(H, msg);
+}
+
+} // namespace snarkfront
@@ -0,0 +1,162 @@
+#ifndef _SNARKFRONT_SHA_NATIVE_HPP_
+#define _SNARKFRONT_SHA_NATIVE_HPP_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "DataBuffer.hpp"
+
+namespace snarkfront {
+
+////////////////////////////////////////////////////////////////////////////////
+// hardware instructions for eval hashing
+//
+// The CPU is checked once at runtime. If it lacks the instructions
+// (or they are disabled), the portable template code is used.
+//
+
+// x86 SHA extensions (SHA-NI) are present and enabled
+bool SHA_NI_enabled();
+
+// turn SHA-NI on or off (for benchmarks and testing, default is on)
+void SHA_NI_enable(const bool a);
+
+// compress one 512-bit block of sixteen 32-bit message words into the
+// SHA-256 hash value, returns false if not done (no hardware support)
+bool SHA256_compress(std::array<std::uint32_t, 8>& H,
+                     const std::uint32_t* W);
+
+// zero knowledge (and other) word types always use the template code
+template <typename T, typename MSG>
+bool SHA256_compress(std::array<T, 8>&, const MSG*) {
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// multi-buffer hashing (independent messages in SIMD lanes)
+//
+// SHA-224/256 have 8 lanes with AVX2, 16 lanes with AVX-512.
+// SHA-384/512/512_224/512_256 have 4 lanes with AVX2, 8 with AVX-512.
+// NONE is the portable code one message at a time (never SHA-NI).
+//
+
+enum class SHA_SIMD { NONE, AVX2, AVX512 };
+
+// widest SIMD instructions present and enabled
+SHA_SIMD SHA_SIMD_enabled();
+
+// limit SIMD instructions (for benchmarks and testing, default is widest)
+void SHA_SIMD_enable(const SHA_SIMD a);
+
+// compress messages of whole blocks, H is initial hash value of each
+// message on input and final hash value on output
+void SHA2_compress_many(std::vector<std::array<std::uint32_t, 8>>& H,
+                        const std::vector<std::vector<std::uint32_t>>& msg);
+
+void SHA2_compress_many(std::vector<std::array<std::uint64_t, 8>>& H,
+                        const std::vector<std::vector<std::uint64_t>>& msg);
+
+// message digests of padded message words (eval SHA-2 only)
+template <typename T>
+std::vector<typename T::DigType>
+digest_many(T hashAlgo, const std::vector<std::vector<typename T::WordType>>& msg)
+{
+    hashAlgo.initHashValue();
+    std::vector<std::array<typename T::WordType, 8>> H(msg.size(),
+                                                       hashAlgo.hashValue());
+
+    SHA2_compress_many(H, msg);
+
+    // truncated digests are set by the hash algorithm
+    std::vector<typename T::DigType> v;
+    v.reserve(H.size());
+    for (const auto& a : H) {
+        hashAlgo.hashValue() = a;
+        hashAlgo.afterHash();
+        v.emplace_back(hashAlgo.digest());
+    }
+
+    return v;
+}
+
+// message digests of padded data
+template <typename T>
+std::vector<typename T::DigType>
+digest_many(T hashAlgo, const std::vector<DataBufferStream>& bufs)
+{
+    typedef typename T::WordType Word;
+
+    std::vector<std::vector<Word>> msg;
+    msg.reserve(bufs.size());
+    for (auto buf : bufs) { // copy as reading words from stream consumes it
+        std::vector<Word> v;
+        while (! buf.empty())
+            v.push_back(buf.getWord<Word>());
+
+        msg.emplace_back(v);
+    }
+
+    return digest_many(hashAlgo, msg);
+}
+
+// big-endian message words with padding (NIST FIPS 180-4 section 5.1)
+// (message size is limited to < 2^64 bits as in SHA_Base::padMessage)
+template <typename WORD>
+std::vector<WORD> padWords(const std::uint8_t* a, const std::size_t len)
+{
+    const std::size_t
+        wordBytes = sizeof(WORD),
+        blockBytes = 16 * wordBytes,
+        totalBytes = (len + 1 + 2 * wordBytes + blockBytes - 1) / blockBytes * blockBytes;
+
+    std::vector<WORD> v(totalBytes / wordBytes, 0);
+
+    for (std::size_t i = 0; i < len; ++i)
+        v[i / wordBytes] |= WORD(a[i]) << (8 * (wordBytes - 1 - i % wordBytes));
+
+    // append bit "1" to end of the message
+    v[len / wordBytes] |= WORD(0x80) << (8 * (wordBytes - 1 - len % wordBytes));
+
+    // length of message in bits is the last 64 bits
+    const std::uint64_t msgLengthBits = 8 * std::uint64_t(len);
+    if (8 == wordBytes) {
+        v.back() = msgLengthBits;
+    } else {
+        v[v.size() - 2] = msgLengthBits >> 32;
+        v.back() = msgLengthBits;
+    }
+
+    return v;
+}
+
+// message digests of data (adds padding)
+template <typename T>
+std::vector<typename T::DigType>
+digest_many(T hashAlgo, const std::vector<std::vector<std::uint8_t>>& a)
+{
+    std::vector<std::vector<typename T::WordType>> msg;
+    msg.reserve(a.size());
+    for (const auto& b : a)
+        msg.emplace_back(padWords<typename T::WordType>(b.data(), b.size()));
+
+    return digest_many(hashAlgo, msg);
+}
+
+template <typename T>
+std::vector<typename T::DigType>
+digest_many(T hashAlgo, const std::vector<std::string>& a)
+{
+    std::vector<std::vector<typename T::WordType>> msg;
+    msg.reserve(a.size());
+    for (const auto& b : a)
+        msg.emplace_back(
+            padWords<typename T::WordType>(
+                reinterpret_cast<const std::uint8_t*>(b.data()), b.size()));
+
+    return digest_many(hashAlgo, msg);
+}
+
+} // namespace snarkfront
+
+#endif
@@ -1,11 +1,17 @@
 #ifndef _SNARKFRONT_SECURE_HASH_STD_HPP_
 #define _SNARKFRONT_SECURE_HASH_STD_HPP_
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdint>
+#include <istream>
 #include <ostream>
 #include <string>
+#include <tuple>
+#include <vector>
 #include "DataBuffer.hpp"
+#include "TLsingleton.hpp"
 
 namespace snarkfront {
 
@@ -34,8 +40,11 @@ class SHA_Base
 public:
     virtual ~SHA_Base() = default;
 
-    static void padMessage(DataBuffer<ClearText>& buf) {
-        const std::size_t msgLengthBits = buf->sizeBits();
+    // prefixBits is length of message prefix blocks already compressed
+    // into a midstate (not in the buffer)
+    static void padMessage(DataBuffer<ClearText>& buf,
+                           const std::size_t prefixBits = 0) {
+        const std::size_t msgLengthBits = prefixBits + buf->sizeBits();
 
         buf.push8(0x80); // append bit "1" to end of the message
 
@@ -53,8 +62,9 @@ public:
         buf.push64(msgLengthBits);
     }
 
-    static void padMessage(DataBufferStream& buf) {
-        padMessage(*buf);
+    static void padMessage(DataBufferStream& buf,
+                           const std::size_t prefixBits = 0) {
+        padMessage(*buf, prefixBits);
     }
 
     static bool padNeeded(const DataBuffer<ClearText>& buf) {
@@ -90,21 +100,155 @@ public:
 
         auto* ptr = static_cast<CRTP*>(this);
 
-        ptr->initHashValue();
+        if (m_midstate) {
+            m_midstate = false; // only once
+        } else {
+            ptr->initHashValue();
+        }
 
         std::size_t msgIndex = 0;
         while (msgIndex < m_message.size()) {
-            ptr->prepMsgSchedule(msgIndex);
-            ptr->initWorkingVars();
-            ptr->workingLoop();
-            ptr->updateHash();
+            ptr->compressBlock(msgIndex);
         }
 
         ptr->afterHash();
     }
 
+    // start from intermediate hash value after whole message blocks of a
+    // prefix, next computeHash() compresses only the message input (for
+    // zk, the prefix costs no constraints as the midstate is constant)
+    template <typename U, std::size_t N>
+    void setMidstate(const std::array<U, N>& a) {
+        auto& H = static_cast<CRTP*>(this)->hashValue();
+#ifdef USE_ASSERT
+        assert(H.size() == N);
+#endif
+
+        for (std::size_t i = 0; i < N; ++i)
+            H[i] = a[i];
+
+        m_midstate = true;
+    }
+
+    // streaming message input (eval only), each block is compressed as
+    // soon as it fills so memory use does not depend on message size
+    // (whole blocks are compressed directly from the input, only bytes
+    // left over are buffered)
+    void update(const std::uint8_t* a, const std::size_t len) {
+        const std::size_t blockBytes = blockSizeBits() / 8;
+
+        if (! m_streaming) {
+            static_cast<CRTP*>(this)->initHashValue();
+            m_streaming = true;
+            m_streamBits = 0;
+            m_block.clear();
+            m_block.reserve(blockBytes);
+        }
+
+        m_streamBits += 8 * len;
+
+        std::size_t i = 0;
+
+        // fill partial block from previous update
+        if (! m_block.empty()) {
+            i = std::min(len, blockBytes - m_block.size());
+            m_block.insert(m_block.end(), a, a + i);
+
+            if (blockBytes != m_block.size()) return;
+
+            streamBlock(m_block.data());
+            m_block.clear();
+        }
+
+        for (; i + blockBytes <= len; i += blockBytes)
+            streamBlock(a + i);
+
+        m_block.insert(m_block.end(), a + i, a + len);
+    }
+
+    void update(const std::vector<std::uint8_t>& a) {
+        update(a.data(), a.size());
+    }
+
+    void update(const std::string& a) {
+        update(reinterpret_cast<const std::uint8_t*>(a.data()), a.size());
+    }
+
+    // consumes the stream
+    void update(DataBufferStream& buf) {
+        std::vector<std::uint8_t> v;
+        v.reserve(blockSizeBits() / 8);
+
+        while (! buf.empty()) {
+            v.push_back(buf.getWord<std::uint8_t>());
+
+            if (v.capacity() == v.size()) {
+                update(v);
+                v.clear();
+            }
+        }
+
+        update(v);
+    }
+
+    // reads until end of stream
+    void update(std::istream& is) {
+        std::vector<char> v(1 << 16);
+
+        while (is.read(v.data(), v.size()) || is.gcount()) {
+            update(reinterpret_cast<const std::uint8_t*>(v.data()), is.gcount());
+        }
+    }
+
+    // pad and compress last block(s), then digest() is the message digest
+    void finalize() {
+        if (! m_streaming) update(nullptr, 0); // empty message
+
+        // append bit "1" to end of the message
+        streamByte(0x80);
+
+        // keep padding zero bits to the length block at the end
+        const std::size_t stopPadBytes = (blockSizeBits() - 2 * wordSizeBits()) / 8;
+        while (stopPadBytes != m_block.size()) {
+            streamByte(0x00);
+        }
+
+        // append length of message (< 2^64 bits in this implementation)
+        for (std::size_t i = 0; i < 2 * wordSizeBits() / 8; ++i) {
+            const std::size_t shift = 8 * (2 * wordSizeBits() / 8 - 1 - i);
+            streamByte(shift < 64 ? (m_streamBits >> shift) : 0);
+        }
+
+#ifdef USE_ASSERT
+        assert(m_block.empty());
+#endif
+
+        m_streaming = false;
+
+        static_cast<CRTP*>(this)->afterHash();
+    }
+
 protected:
-    SHA_Base() = default;
+    SHA_Base()
+        : m_midstate(false),
+          m_streaming(false),
+          m_streamBits(0)
+    {}
+
+    // one message block (derived class may override with hardware)
+    void compressBlock(std::size_t& msgIndex) {
+        auto* ptr = static_cast<CRTP*>(this);
+
+        ptr->prepMsgSchedule(msgIndex);
+        ptr->initWorkingVars();
+        ptr->workingLoop();
+        ptr->updateHash();
+    }
+
+    // contiguous message words starting at index
+    const MSG* msgBlock(const std::size_t index) const {
+        return m_message.data() + index;
+    }
 
     // note: reference not const so assignment can unbox laziness
     MSG& msgWord(std::size_t& index) {
@@ -126,6 +270,35 @@ private:
         }
     }
 
+    // compress block of bytes (message words are big-endian)
+    void streamBlock(const std::uint8_t* p) {
+        const std::size_t wordBytes = wordSizeBits() / 8;
+
+        m_message.clear();
+        for (std::size_t i = 0; i < blockSizeBits() / 8; i += wordBytes) {
+            MSG w = 0;
+            for (std::size_t j = 0; j < wordBytes; ++j)
+                w = (w << 8) | p[i + j];
+
+            m_message.emplace_back(w);
+        }
+
+        std::size_t msgIndex = 0;
+        static_cast<CRTP*>(this)->compressBlock(msgIndex);
+
+        m_message.clear();
+    }
+
+    // compress block when full (padding)
+    void streamByte(const std::uint8_t c) {
+        m_block.push_back(c);
+
+        if (blockSizeBits() / 8 == m_block.size()) {
+            streamBlock(m_block.data());
+            m_block.clear();
+        }
+    }
+
     bool inputOK() const {
         // non-empty message must be even number of message input blocks
         const std::size_t msgSizeBits = m_message.size() * wordSizeBits();
@@ -133,6 +306,42 @@ private:
     }
 
     std::vector<MSG> m_message;
+
+    // computeHash() starts from hash value set by setMidstate()
+    bool m_midstate;
+
+    // streaming input state
+    bool m_streaming;
+    std::uint64_t m_streamBits;
+    std::vector<std::uint8_t> m_block; // partial block
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// constant words (round constants and initial hash values)
+// (built once per thread and word type, shared by all hash objects)
+//
+
+template <typename T, typename F, typename VALUES>
+class SHA_Constants
+{
+    typedef decltype(VALUES::values()) ValueArray;
+    typedef std::array<T, std::tuple_size<ValueArray>::value> WordArray;
+
+public:
+    SHA_Constants() {
+        const ValueArray a = VALUES::values();
+
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            m_words[i] = F::constant(a[i]);
+        }
+    }
+
+    static const WordArray& words() {
+        return TL<SHA_Constants>::singleton()->m_words;
+    }
+
+private:
+    WordArray m_words;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -143,21 +352,21 @@ template <typename T, typename U, typename BITWISE>
 class SHA_Functions : public BITWISE
 {
 public:
-    static U Ch(const T& x, const T& y, const T& z) {
+    static constexpr U Ch(const T& x, const T& y, const T& z) {
         return
             BITWISE::XOR(
                 BITWISE::_AND(x, y),
                 BITWISE::_AND(BITWISE::_CMPLMNT(x), z));
     }
 
-    static U Parity(const T& x, const T& y, const T& z) {
+    static constexpr U Parity(const T& x, const T& y, const T& z) {
         return
             BITWISE::XOR(
                 BITWISE::_XOR(x, y),
                 z);
     }
 
-    static U Maj(const T& x, const T& y, const T& z) {
+    static constexpr U Maj(const T& x, const T& y, const T& z) {
         return
             BITWISE::XOR(
                 BITWISE::_XOR(
@@ -166,29 +375,25 @@ public:
                 BITWISE::_AND(y, z));
     }
 
-    static U f(const T& x, const T& y, const T& z, const std::size_t round) {
-        if (round < 20) {
-            return Ch(x, y, z);
-        } else if (round < 40) {
-            return Parity(x, y, z);
-        } else if (round < 60) {
-            return Maj(x, y, z);
-        } else {
-            return Parity(x, y, z);
-        }
+    static constexpr U f(const T& x, const T& y, const T& z, const std::size_t round) {
+        return
+            round < 20 ? Ch(x, y, z) :
+            round < 40 ? Parity(x, y, z) :
+            round < 60 ? Maj(x, y, z) :
+            Parity(x, y, z);
     }
 
-    static U SIGMA_256_0(const T& x) { return SIGMA(x, 2, 13, 22); }
-    static U SIGMA_256_1(const T& x) { return SIGMA(x, 6, 11, 25); }
-    static U sigma_256_0(const T& x) { return sigma(x, 7, 18, 3); }
-    static U sigma_256_1(const T& x) { return sigma(x, 17, 19, 10); }
-    static U SIGMA_512_0(const T& x) { return SIGMA(x, 28, 34, 39); }
-    static U SIGMA_512_1(const T& x) { return SIGMA(x, 14, 18, 41); }
-    static U sigma_512_0(const T& x) { return sigma(x, 1, 8, 7); }
-    static U sigma_512_1(const T& x) { return sigma(x, 19, 61, 6); }
+    static constexpr U SIGMA_256_0(const T& x) { return SIGMA(x, 2, 13, 22); }
+    static constexpr U SIGMA_256_1(const T& x) { return SIGMA(x, 6, 11, 25); }
+    static constexpr U sigma_256_0(const T& x) { return sigma(x, 7, 18, 3); }
+    static constexpr U sigma_256_1(const T& x) { return sigma(x, 17, 19, 10); }
+    static constexpr U SIGMA_512_0(const T& x) { return SIGMA(x, 28, 34, 39); }
+    static constexpr U SIGMA_512_1(const T& x) { return SIGMA(x, 14, 18, 41); }
+    static constexpr U sigma_512_0(const T& x) { return sigma(x, 1, 8, 7); }
+    static constexpr U sigma_512_1(const T& x) { return sigma(x, 19, 61, 6); }
 
 private:
-    static U SIGMA(const T& x,
+    static constexpr U SIGMA(const T& x,
                    const unsigned int a,
                    const unsigned int b,
                    const unsigned int c) {
@@ -200,7 +405,7 @@ private:
                 BITWISE::_ROTR(x, c));
     }
 
-    static U sigma(const T& x,
+    static constexpr U sigma(const T& x,
                    const unsigned int a,
                    const unsigned int b,
                    const unsigned int c) {
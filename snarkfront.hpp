@@ -22,7 +22,9 @@
 #include "InitPairing.hpp"
 
 // Merkle tree
+#include "MerkleFile.hpp"
 #include "MerkleTree.hpp"
+#include "MiMC.hpp"
 
 // Secure Hash Algorithms
 #include "SHA_1.hpp"
@@ -32,5 +34,9 @@
 #include "SHA_512.hpp"
 #include "SHA_512_224.hpp"
 #include "SHA_512_256.hpp"
+#include "SHA_Constexpr.hpp"
+
+// BLAKE2s
+#include "BLAKE_2s.hpp"
 
 #endif
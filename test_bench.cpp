@@ -0,0 +1,607 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <unistd.h>
+#include <vector>
+#include "snarkfront.hpp"
+
+using namespace snarkfront;
+using namespace std;
+
+void printUsage(const char* exeName) {
+    cout << "usage: " << exeName
+         << " -p BN128|Edwards -m witness|sha256|many|blake2s|range|merkle [-n count]" << endl
+         << endl
+         << "value to field witness conversions per second:" << endl
+         << exeName << " -p BN128 -m witness -n 1000000" << endl
+         << endl
+         << "eval SHA-256 one block hashes per second (portable and SHA-NI):" << endl
+         << exeName << " -p BN128 -m sha256 -n 1000000" << endl
+         << endl
+         << "eval SHA-256 and SHA-512 multi-buffer hashing of 64 byte messages:" << endl
+         << exeName << " -p BN128 -m many -n 1000000" << endl
+         << endl
+         << "BLAKE2s test vectors and zk constraints per message byte (vs SHA-256):" << endl
+         << exeName << " -p BN128 -m blake2s -n 256" << endl
+         << endl
+         << "range checked big integers converted to words, proof for each width:" << endl
+         << exeName << " -p BN128 -m range" << endl
+         << endl
+         << "Merkle tree (SHA-256) leaf appends per second at depths 20 and 32:" << endl
+         << exeName << " -p BN128 -m merkle -n 100000" << endl;
+
+    exit(EXIT_FAILURE);
+}
+
+// elapsed seconds since start
+double elapsed(const chrono::steady_clock::time_point& start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void printRate(const string& label, const size_t count, const double seconds) {
+    cout << label << " " << size_t(count / seconds) << " per second" << endl;
+}
+
+// machine integer to field witness, decimal string and byte table
+// paths (valueToWitness uses the table)
+template <typename ALG>
+bool benchWitness(const string& label, const vector<typename ALG::ValueType>& v)
+{
+    typedef typename ALG::FrType FR;
+
+    vector<FR> a, b;
+    a.reserve(v.size());
+    b.reserve(v.size());
+
+    auto start = chrono::steady_clock::now();
+    for (const auto& x : v)
+        a.emplace_back(FR(ALG::valueToString(x)));
+    printRate(label + " string", v.size(), elapsed(start));
+
+    auto& POW2 = TL<PowersOf2<FR>>::singleton();
+    start = chrono::steady_clock::now();
+    for (const auto& x : v)
+        b.emplace_back(POW2->getNumber(x));
+    printRate(label + " table", v.size(), elapsed(start));
+
+    return a == b && a.front() == ALG::valueToWitness(v.front());
+}
+
+template <typename PAIRING>
+bool runWitness(const size_t count)
+{
+    typedef typename PAIRING::Fr FR;
+
+    random_device rd;
+    mt19937_64 gen(rd());
+
+    vector<uint32_t> v32;
+    vector<uint64_t> v64;
+    v32.reserve(count);
+    v64.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t a = gen();
+
+        v32.push_back(a);
+        v64.push_back(a);
+    }
+
+    // warm up the look up tables
+    TL<PowersOf2<FR>>::singleton()->getNumber(v64.front());
+
+    bool ok = true;
+    if (! benchWitness<Alg_uint32<FR>>("uint32", v32)) ok = false;
+    if (! benchWitness<Alg_uint64<FR>>("uint64", v64)) ok = false;
+
+    return ok;
+}
+
+// eval SHA-256 of one block messages (same as Merkle tree nodes)
+vector<array<uint32_t, 8>> benchSHA256(const string& label,
+                                       const vector<uint32_t>& v)
+{
+    vector<array<uint32_t, 8>> a;
+    a.reserve(v.size() / 16);
+
+    const auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < v.size(); i += 16) {
+        eval::SHA256 hashAlgo;
+        for (size_t j = i; j < i + 16; ++j)
+            hashAlgo.msgInput(v[j]);
+
+        hashAlgo.computeHash();
+        a.emplace_back(hashAlgo.digest());
+    }
+    printRate(label, a.size(), elapsed(start));
+
+    return a;
+}
+
+bool runSHA256(const size_t count)
+{
+    random_device rd;
+    mt19937 gen(rd());
+
+    vector<uint32_t> v;
+    v.reserve(16 * count);
+    for (size_t i = 0; i < 16 * count; ++i)
+        v.push_back(gen());
+
+    const bool hardware = SHA_NI_enabled();
+
+    SHA_NI_enable(false);
+    const auto a = benchSHA256("sha256 portable", v);
+    SHA_NI_enable(hardware);
+
+    if (! hardware) {
+        cout << "sha256 SHA-NI not available" << endl;
+        return true;
+    }
+
+    return a == benchSHA256("sha256 SHA-NI", v);
+}
+
+void printThroughput(const string& label,
+                     const size_t count,
+                     const size_t bytes,
+                     const double seconds) {
+    cout << label << " " << size_t(count / seconds) << " hashes/s "
+         << size_t(count * bytes / seconds / 1000000) << " MB/s" << endl;
+}
+
+// one digest at a time and multi-buffer with each SIMD level
+template <typename EVAL_SHA>
+bool benchMany(const string& label, const vector<vector<uint8_t>>& v)
+{
+    const size_t bytes = v.front().size();
+
+    auto start = chrono::steady_clock::now();
+    vector<typename EVAL_SHA::DigType> a;
+    a.reserve(v.size());
+    for (const auto& m : v)
+        a.emplace_back(digest(EVAL_SHA(), m));
+    printThroughput(label + " digest", v.size(), bytes, elapsed(start));
+
+    bool ok = true;
+
+    start = chrono::steady_clock::now();
+    vector<typename EVAL_SHA::DigType> c;
+    c.reserve(v.size());
+    for (const auto& m : v)
+        c.emplace_back(digest_constexpr<EVAL_SHA>(m));
+    printThroughput(label + " digest_constexpr", v.size(), bytes, elapsed(start));
+
+    if (a != c) ok = false;
+
+    const SHA_SIMD widest = SHA_SIMD_enabled();
+
+    for (const auto simd : { SHA_SIMD::NONE, SHA_SIMD::AVX2, SHA_SIMD::AVX512 }) {
+        if (simd > widest) break;
+        SHA_SIMD_enable(simd);
+
+        start = chrono::steady_clock::now();
+        const auto b = digest_many(EVAL_SHA(), v);
+        printThroughput(label + " digest_many " +
+                        (SHA_SIMD::NONE == simd ? "scalar" :
+                         SHA_SIMD::AVX2 == simd ? "AVX2" : "AVX-512"),
+                        v.size(), bytes, elapsed(start));
+
+        if (a != b) ok = false;
+    }
+
+    SHA_SIMD_enable(widest);
+
+    return ok;
+}
+
+bool runMany(const size_t count)
+{
+    random_device rd;
+    mt19937 gen(rd());
+
+    vector<vector<uint8_t>> v(count, vector<uint8_t>(64));
+    for (auto& m : v)
+        for (auto& c : m)
+            c = gen();
+
+    bool ok = true;
+    if (! benchMany<eval::SHA224>("sha224", v)) ok = false;
+    if (! benchMany<eval::SHA256>("sha256", v)) ok = false;
+    if (! benchMany<eval::SHA384>("sha384", v)) ok = false;
+    if (! benchMany<eval::SHA512>("sha512", v)) ok = false;
+    if (! benchMany<eval::SHA512_224>("sha512_224", v)) ok = false;
+    if (! benchMany<eval::SHA512_256>("sha512_256", v)) ok = false;
+
+    return ok;
+}
+
+// BLAKE2s digest bytes are little-endian words
+string blake2sHex(const array<uint32_t, 8>& a)
+{
+    vector<uint8_t> v;
+    for (const auto w : a)
+        for (size_t i = 0; i < 4; ++i)
+            v.push_back(w >> (8 * i));
+
+    return asciiHex(v);
+}
+
+// zk constraints per message byte
+template <typename PAIRING, typename ZK_HASH>
+double constraintsPerByte(const size_t bytes)
+{
+    reset<PAIRING>();
+    digest(ZK_HASH(), vector<uint8_t>(bytes, 0x61));
+    return double(constraint_count<PAIRING>()) / bytes;
+}
+
+// test vectors (RFC 7693 appendix B, unkeyed reference KAT) then
+// constraint cost for message sizes up to count bytes
+template <typename PAIRING>
+bool runBLAKE2s(const size_t count)
+{
+    typedef typename PAIRING::Fr FR;
+
+    const vector<pair<vector<uint8_t>, string>> KAT = {
+        { {}, "69217a3079908094e11121d042354a7c1f55b6482ca1a51e1b250dfd1ed0eef9" },
+        { {'a', 'b', 'c'}, "508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982" },
+        { {0}, "e34d74dbaf4ff4c6abd871cc220451d2ea2648846c7757fbaac82fe51ad64bea" },
+        { vector<uint8_t>(63), "e57cb79487dd57902432b250733813bd96a84efce59f650fac26e6696aefafc3" },
+        { vector<uint8_t>(64), "56f34e8b96557e90c1f24b52d0c89d51086acf1b00f634cf1dde9233b8eaaa3e" },
+        { vector<uint8_t>(65), "1b53ee94aaf34e4b159d48de352c7f0661d0a40edff95a0b1639b4090e974472" },
+        { vector<uint8_t>(255), "f03f5789d3336b80d002d59fdf918bdb775b00956ed5528e86aa994acb38fe2d" } };
+
+    bool ok = true;
+
+    for (auto test : KAT) {
+        // the reference KAT messages are 0, 1, 2,...
+        if (test.first.size() > 3)
+            for (size_t i = 0; i < test.first.size(); ++i)
+                test.first[i] = i;
+
+        const auto eval_digest = digest(eval::BLAKE2s(), test.first);
+
+        reset<PAIRING>();
+        const auto zk_digest = digest(zk::BLAKE2s<FR>(), test.first);
+
+        bool match = (blake2sHex(eval_digest) == test.second);
+        for (size_t i = 0; i < zk_digest.size(); ++i)
+            if (zk_digest[i]->value() != eval_digest[i]) match = false;
+
+        cout << "blake2s " << test.first.size() << " bytes "
+             << (match ? "OK" : "FAIL") << endl;
+
+        if (! match) ok = false;
+    }
+
+    for (size_t bytes = 32; bytes <= count; bytes *= 2) {
+        cout << bytes << " bytes constraints per byte"
+             << " blake2s " << size_t(constraintsPerByte<PAIRING, zk::BLAKE2s<FR>>(bytes))
+             << " sha256 " << size_t(constraintsPerByte<PAIRING, zk::SHA256<FR>>(bytes))
+             << endl;
+    }
+
+    return ok;
+}
+
+// range checked big integer converted to 32-bit and 64-bit words
+template <typename PAIRING>
+bool proveRange(const size_t width, const uint64_t a)
+{
+    typedef typename PAIRING::Fr FR;
+
+    reset<PAIRING>();
+
+    bigint_x<FR> x;
+    bless(x, a, width);
+
+    end_input<PAIRING>();
+
+    array<uint32_x<FR>, 4> w32;
+    bless(w32, x);
+
+    array<uint64_x<FR>, 2> w64;
+    bless(w64, x);
+
+    assert_true(w32[0] == uint32_t(a));
+    assert_true(w32[1] == uint32_t(a >> 32));
+    assert_true(w32[2] == 0);
+    assert_true(w32[3] == 0);
+    assert_true(w64[0] == a);
+    assert_true(w64[1] == 0);
+
+    GenericProgressBar progress(cerr);
+    const auto key = keypair<PAIRING>(progress);
+    const auto in = input<PAIRING>();
+    const auto p = proof(key, progress);
+
+    return verify(key, in, p, progress);
+}
+
+template <typename PAIRING>
+bool runRange()
+{
+    random_device rd;
+    mt19937_64 gen(rd());
+
+    bool ok = true;
+
+    for (const size_t width : { 1, 32, 37, 64, 100, 128 }) {
+        const uint64_t a = width < 64 ? gen() >> (64 - width) : gen();
+        const bool proofOK = proveRange<PAIRING>(width, a);
+
+        cerr << endl;
+        cout << "range width " << width << " proof "
+             << (proofOK ? "OK" : "FAIL") << endl;
+
+        if (! proofOK) ok = false;
+    }
+
+    return ok;
+}
+
+void removeMerkleDir(const string& dir, const size_t depth)
+{
+    for (size_t i = 0; i <= depth; ++i)
+        remove((dir + "/level_" + to_string(i)).c_str());
+    remove((dir + "/footer").c_str());
+    rmdir(dir.c_str());
+}
+
+// every authentication path of reopened file tree matches memory
+bool sameMerkle(const MerkleFileStore_SHA256& file, const MerkleStore_SHA256& mem)
+{
+    if (file.size() != mem.size() || file.rootHash() != mem.rootHash())
+        return false;
+
+    for (size_t i = 0; i < mem.size(); ++i) {
+        const auto a = file.authPath(i), b = mem.authPath(i);
+
+        if (a.siblings() != b.siblings()
+            || a.rootPath() != b.rootPath()
+            || a.childBits() != b.childBits()) return false;
+    }
+
+    return true;
+}
+
+// open, add, commit, reopen, add, commit, reopen
+// (leaves added after the last commit are lost on reopen)
+bool checkMerkleFile(const size_t depth, const vector<array<uint32_t, 8>>& leaves)
+{
+    char dir[] = "/tmp/snarkfront_merkle_XXXXXX";
+    if (! mkdtemp(dir)) return false;
+
+    const auto half = leaves.begin() + leaves.size() / 2;
+    MerkleStore_SHA256 mem(depth);
+    bool ok = true;
+
+    {
+        MerkleFileStore_SHA256 file;
+        if (! file.open(dir, depth)) ok = false;
+        file.addLeaves(leaves.begin(), half);
+        if (! file.commit()) ok = false;
+        mem.addLeaves(leaves.begin(), half);
+    }
+
+    {
+        MerkleFileStore_SHA256 file;
+        if (! file.open(dir, depth) || ! sameMerkle(file, mem)) ok = false;
+        file.addLeaves(half, leaves.end());
+        if (! file.commit()) ok = false;
+        mem.addLeaves(half, leaves.end());
+    }
+
+    {
+        // crash after adding leaves, no commit
+        MerkleFileStore_SHA256 file;
+        if (! file.open(dir, depth) || ! sameMerkle(file, mem)) ok = false;
+        file.addLeaves(leaves.begin(), half);
+        file.rootHash();
+    }
+
+    {
+        // uncommitted leaves are overwritten
+        MerkleFileStore_SHA256 file;
+        if (! file.open(dir, depth) || ! sameMerkle(file, mem)) ok = false;
+        file.addLeaf(leaves.front());
+        if (! file.commit()) ok = false;
+        mem.addLeaf(leaves.front());
+    }
+
+    {
+        MerkleFileStore_SHA256 file;
+        if (! file.open(dir, depth) || ! sameMerkle(file, mem)) ok = false;
+    }
+
+    removeMerkleDir(dir, depth);
+
+    cout << "merkle depth " << depth << " file reopen "
+         << (ok ? "OK" : "FAIL") << endl;
+
+    return ok;
+}
+
+// root hash after every leaf and once after all leaves
+bool benchMerkle(const size_t depth, const vector<array<uint32_t, 8>>& leaves)
+{
+    const string label = "merkle depth " + to_string(depth);
+
+    MerkleStore_SHA256 eager(depth), lazy(depth);
+
+    auto start = chrono::steady_clock::now();
+    for (const auto& a : leaves) {
+        eager.addLeaf(a);
+        eager.rootHash();
+    }
+    printRate(label + " addLeaf", leaves.size(), elapsed(start));
+
+    start = chrono::steady_clock::now();
+    lazy.addLeaves(leaves);
+    lazy.rootHash();
+    printRate(label + " addLeaves", leaves.size(), elapsed(start));
+
+    const auto a = eager.authPath(leaves.size() / 2), b = lazy.authPath(leaves.size() / 2);
+
+    bool ok = eager.rootHash() == lazy.rootHash()
+        && a.siblings() == b.siblings()
+        && a.rootPath() == b.rootPath();
+
+    // complete tree with worker threads, doubling up to one per core
+    const size_t cores = max<size_t>(1, thread::hardware_concurrency());
+    vector<size_t> threadCounts;
+    for (size_t t = 1; t < cores; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(cores);
+
+    for (const auto threads : threadCounts) {
+        start = chrono::steady_clock::now();
+        const auto c = makeMerkleTree<MerkleStore_SHA256>(depth, leaves, threads);
+        printRate(label + " build " + to_string(threads) + " threads",
+                  leaves.size(),
+                  elapsed(start));
+
+        if (c.rootHash() != lazy.rootHash()) ok = false;
+    }
+
+    // keep all leaves then find and remove them by digest
+    auto bundle = makeMerkleBundle<MerkleBundle_SHA256<size_t>>(depth, leaves, true);
+
+    start = chrono::steady_clock::now();
+    for (const auto& cm : leaves) {
+        if (bundle.authLeaf()[bundle.authFind(cm)] != cm) ok = false;
+    }
+    printRate(label + " authFind", leaves.size(), elapsed(start));
+
+    start = chrono::steady_clock::now();
+    if (leaves.size() != bundle.authRemove(leaves)) ok = false;
+    printRate(label + " authRemove", leaves.size(), elapsed(start));
+
+    if (! bundle.authLeaf().empty()) ok = false;
+
+    // memory-mapped files in a temporary directory
+    char dir[] = "/tmp/snarkfront_merkle_XXXXXX";
+    if (mkdtemp(dir)) {
+        MerkleFileStore_SHA256 file;
+        start = chrono::steady_clock::now();
+        if (! file.open(dir, depth)) ok = false;
+        file.addLeaves(leaves);
+        if (! file.commit()) ok = false;
+        printRate(label + " file commit", leaves.size(), elapsed(start));
+
+        // reopen reads only the footer
+        MerkleFileStore_SHA256 reopen;
+        start = chrono::steady_clock::now();
+        if (! reopen.open(dir, depth)) ok = false;
+        cout << label << " file open " << elapsed(start) << " seconds" << endl;
+
+        if (reopen.rootHash() != lazy.rootHash()) ok = false;
+
+        removeMerkleDir(dir, depth);
+    }
+
+    // persistence of a smaller tree, every path checked
+    const size_t n = min<size_t>(leaves.size(), 1000);
+    if (! checkMerkleFile(depth, vector<array<uint32_t, 8>>(leaves.begin(), leaves.begin() + n)))
+        ok = false;
+
+    return ok;
+}
+
+bool runMerkle(const size_t count)
+{
+    random_device rd;
+    mt19937 gen(rd());
+
+    vector<array<uint32_t, 8>> v(count);
+    for (auto& a : v)
+        for (auto& w : a)
+            w = gen();
+
+    bool ok = true;
+    for (const size_t depth : { 20, 32 }) {
+        const size_t n = min(count, size_t(1) << depth);
+        if (! benchMerkle(depth, vector<array<uint32_t, 8>>(v.begin(), v.begin() + n)))
+            ok = false;
+    }
+
+    return ok;
+}
+
+template <typename PAIRING>
+bool runTest(const string& mode, const size_t count)
+{
+    if ("witness" == mode) {
+        return runWitness<PAIRING>(count);
+
+    } else if ("sha256" == mode) {
+        return runSHA256(count);
+
+    } else if ("many" == mode) {
+        return runMany(count);
+
+    } else if ("blake2s" == mode) {
+        return runBLAKE2s<PAIRING>(count);
+
+    } else if ("range" == mode) {
+        return runRange<PAIRING>();
+
+    } else if ("merkle" == mode) {
+        return runMerkle(count);
+    }
+
+    return false;
+}
+
+int main(int argc, char *argv[])
+{
+    // command line switches
+    string pairing, mode;
+    size_t count = 1000000;
+    int opt;
+    while (-1 != (opt = getopt(argc, argv, "p:m:n:"))) {
+        switch (opt) {
+        case ('p') :
+            pairing = optarg;
+            break;
+        case ('m') :
+            mode = optarg;
+            break;
+        case ('n') :
+            count = atol(optarg);
+            break;
+        }
+    }
+
+    if (mode.empty() || 0 == count) printUsage(argv[0]);
+
+    bool result;
+
+    if (pairingBN128(pairing)) {
+        // Barreto-Naehrig 128 bits
+        init_BN128();
+        result = runTest<BN128_PAIRING>(mode, count);
+
+    } else if (pairingEdwards(pairing)) {
+        // Edwards 80 bits
+        init_Edwards();
+        result = runTest<EDWARDS_PAIRING>(mode, count);
+
+    } else {
+        // no elliptic curve specified
+        printUsage(argv[0]);
+    }
+
+    cout << "test " << (result ? "passed" : "failed") << endl;
+
+    exit(EXIT_SUCCESS);
+}
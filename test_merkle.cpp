@@ -1,3 +1,4 @@
+#include <array>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
@@ -13,22 +14,64 @@ using namespace std;
 void printUsage(const char* exeName) {
     cout << "usage: " << exeName
          << " -p BN128|Edwards"
-            " -b 256|512"
+            " -b 256|512|mimc"
             " -d tree_depth"
             " -i leaf_number"
+            " [-n leaf_count]"
+            " [-s]"
+            " [-k proof_count]"
          << endl;
 
     exit(EXIT_FAILURE);
 }
 
+// leaf digest is the leaf number
+template <size_t N>
+void leafDigest(array<uint32_t, N>& a, const size_t n) {
+    a = {static_cast<uint32_t>(n)};
+}
+
+template <size_t N>
+void leafDigest(array<uint64_t, N>& a, const size_t n) {
+    a = {n};
+}
+
+template <typename FR, size_t N>
+void leafDigest(array<FR, N>& a, const size_t n) {
+    a.fill(FR::zero());
+    a[0] = TL<PowersOf2<FR>>::singleton()->getNumber(n);
+}
+
+// SHA digests in hexadecimal, field elements in decimal
+template <size_t N>
+string digestString(const array<uint32_t, N>& a) {
+    return asciiHex(a, true);
+}
+
+template <size_t N>
+string digestString(const array<uint64_t, N>& a) {
+    return asciiHex(a, true);
+}
+
+template <typename FR, size_t N>
+string digestString(const array<FR, N>& a) {
+    stringstream ss;
+    for (const auto& r : a)
+        ss << r << " ";
+    return ss.str();
+}
+
 template <typename PAIRING, typename BUNDLE, typename ZK_PATH>
 void runTest(const size_t treeDepth,
-             const size_t leafNumber)
+             const size_t leafNumber,
+             const size_t leafCount)
 {
     BUNDLE bundle(treeDepth);
 
-    while (! bundle.isFull()) {
-        const typename BUNDLE::DigType leaf{bundle.treeSize()};
+    // fill the tree unless a smaller leaf count is specified
+    while (! bundle.isFull() && leafCount != bundle.treeSize()) {
+        typename BUNDLE::DigType leaf;
+        leafDigest(leaf, bundle.treeSize());
 
         bundle.addLeaf(
             leaf,
@@ -44,7 +87,7 @@ void runTest(const size_t treeDepth,
     }
 
     const auto& leaf = bundle.authLeaf().front();
-    const auto& authPath = bundle.authPath().front();
+    const auto authPath = bundle.authPath(0);
 
     cout << "leaf " << leafNumber << " child bits ";
     for (int i = authPath.childBits().size() - 1; i >= 0; --i) {
@@ -55,13 +98,13 @@ void runTest(const size_t treeDepth,
     cout << "root path" << endl;
     for (int i = authPath.rootPath().size() - 1; i >= 0; --i) {
         cout << "[" << i << "] "
-             << asciiHex(authPath.rootPath()[i], true) << endl;
+             << digestString(authPath.rootPath()[i]) << endl;
     }
 
     cout << "siblings" << endl;
     for (int i = authPath.siblings().size() - 1; i >= 0; --i) {
         cout << "[" << i << "] "
-             << asciiHex(authPath.siblings()[i], true) << endl;
+             << digestString(authPath.siblings()[i]) << endl;
     }
 
     typename ZK_PATH::DigType rt;
@@ -77,29 +120,212 @@ void runTest(const size_t treeDepth,
 
     assert_true(rt == zkAuthPath.rootHash());
 
-    cout << "variable count " << variable_count<PAIRING>() << endl;
+    cout << "variable count " << variable_count<PAIRING>() << endl
+         << "constraint count " << constraint_count<PAIRING>() << endl;
+}
+
+// proof_count leaves from leaf_number in one multiproof
+template <typename PAIRING, typename BUNDLE, typename ZK_MULTI>
+void runMulti(const size_t treeDepth,
+              const size_t leafNumber,
+              const size_t leafCount,
+              const size_t proofCount)
+{
+    BUNDLE bundle(treeDepth);
+
+    // fill the tree unless a smaller leaf count is specified
+    while (! bundle.isFull() && leafCount != bundle.treeSize()) {
+        typename BUNDLE::DigType leaf;
+        leafDigest(leaf, bundle.treeSize());
+
+        bundle.addLeaf(
+            leaf,
+            leafNumber <= bundle.treeSize() && bundle.treeSize() < leafNumber + proofCount);
+    }
+
+    if (leafNumber + proofCount > bundle.treeSize()) {
+        cout << "leaf number " << leafNumber + proofCount - 1
+             << " is larger than " << bundle.treeSize()
+             << endl;
+
+        exit(EXIT_FAILURE);
+    }
+
+    const MerkleMultiPath<typename BUNDLE::HashType, int> multiPath(bundle.authPath());
+
+    cout << "leaves " << leafNumber << " to " << leafNumber + proofCount - 1
+         << " hash count " << multiPath.hashCount()
+         << " (separate paths " << proofCount * treeDepth << ")" << endl
+         << "root " << digestString(multiPath.rootHash()) << endl;
+
+    typename ZK_MULTI::DigType rt;
+    bless(rt, multiPath.rootHash());
+
+    end_input<PAIRING>();
+
+    vector<typename ZK_MULTI::DigType> zkLeaves;
+    for (const auto& leaf : bundle.authLeaf()) {
+        typename ZK_MULTI::DigType zkLeaf;
+        bless(zkLeaf, leaf);
+        zkLeaves.emplace_back(zkLeaf);
+    }
+
+    ZK_MULTI zkMultiPath(multiPath);
+    zkMultiPath.updatePath(zkLeaves);
+
+    assert_true(rt == zkMultiPath.rootHash());
+
+    cout << "variable count " << variable_count<PAIRING>() << endl
+         << "constraint count " << constraint_count<PAIRING>() << endl;
+}
+
+// sparse tree with leaves at keys that are SHA-256 digests of the leaf
+// numbers, a leaf number not in the tree is proved absent (zero leaf)
+// at its key (public input)
+template <typename PAIRING, typename SPARSE, typename ZK_PATH>
+void runSparse(const size_t treeDepth,
+               const size_t leafNumber,
+               const size_t leafCount)
+{
+    typedef typename PAIRING::Fr FR;
+
+    SPARSE tree(treeDepth);
+
+    const size_t count = (size_t(-1) == leafCount) ? leafNumber + 1 : leafCount;
+    for (size_t i = 0; i < count; ++i) {
+        typename SPARSE::DigType leaf;
+        leafDigest(leaf, i + 1); // zero leaf is empty
+
+        // keys truncated to depth bits may collide
+        if (! tree.setLeaf(digest(eval::SHA256(), to_string(i)), leaf))
+            cout << "leaf " << i << " key collision, not added" << endl;
+    }
+
+    const auto key = digest(eval::SHA256(), to_string(leafNumber));
+    const auto leaf = tree.leaf(key);
+    const auto authPath = tree.authPath(key);
+
+    cout << "leaf " << leafNumber << " key " << asciiHex(key, true)
+         << (tree.contains(key) ? " membership" :
+             tree.occupied(key) ? " index has another key (no proof)" :
+             " non-membership")
+         << endl
+         << "root " << digestString(tree.rootHash()) << endl;
+
+    typename ZK_PATH::DigType rt;
+    bless(rt, tree.rootHash());
+
+    // path must be for this key
+    vector<bool_x<FR>> zkKey;
+    for (const auto b : tree.keyBits(key)) {
+        bool_x<FR> zkBit;
+        bless(zkBit, bool(b));
+        zkKey.emplace_back(zkBit);
+    }
+
+    end_input<PAIRING>();
+
+    typename ZK_PATH::DigType zkLeaf;
+    bless(zkLeaf, leaf);
+
+    ZK_PATH zkAuthPath(authPath);
+    zkAuthPath.updatePath(zkLeaf);
+
+    assert_true(rt == zkAuthPath.rootHash());
+    assert_key(zkAuthPath, zkKey);
+
+    cout << "variable count " << variable_count<PAIRING>() << endl
+         << "constraint count " << constraint_count<PAIRING>() << endl;
 }
 
 template <typename PAIRING>
 bool runTest(const string& shaBits,
+             const bool sparse,
              const size_t treeDepth,
-             const size_t leafNumber)
+             const size_t leafNumber,
+             const size_t leafCount,
+             const size_t proofCount)
 {
     typedef typename PAIRING::Fr FR;
 
-    if ("256" == shaBits) {
+    if (proofCount > 1) {
+        if ("256" == shaBits) {
+            runMulti<PAIRING,
+                     MerkleBundle_SHA256<uint32_t>,
+                     zk::MerkleMultiPath_SHA256<FR>>(
+                treeDepth,
+                leafNumber,
+                leafCount,
+                proofCount);
+
+        } else if ("512" == shaBits) {
+            runMulti<PAIRING,
+                     MerkleBundle_SHA512<uint64_t>,
+                     zk::MerkleMultiPath_SHA512<FR>>(
+                treeDepth,
+                leafNumber,
+                leafCount,
+                proofCount);
+
+        } else if ("mimc" == shaBits) {
+            runMulti<PAIRING,
+                     MerkleBundle_MiMC<FR, uint32_t>,
+                     zk::MerkleMultiPath_MiMC<FR>>(
+                treeDepth,
+                leafNumber,
+                leafCount,
+                proofCount);
+        }
+
+    } else if (sparse) {
+        if ("256" == shaBits) {
+            runSparse<PAIRING,
+                      MerkleSparseTree_SHA256,
+                      zk::MerkleAuthPath_SHA256<FR>>(
+                treeDepth,
+                leafNumber,
+                leafCount);
+
+        } else if ("512" == shaBits) {
+            runSparse<PAIRING,
+                      MerkleSparseTree_SHA512,
+                      zk::MerkleAuthPath_SHA512<FR>>(
+                treeDepth,
+                leafNumber,
+                leafCount);
+
+        } else if ("mimc" == shaBits) {
+            runSparse<PAIRING,
+                      MerkleSparseTree_MiMC<FR>,
+                      zk::MerkleAuthPath_MiMC<FR>>(
+                treeDepth,
+                leafNumber,
+                leafCount);
+        }
+
+    } else if ("256" == shaBits) {
         runTest<PAIRING,
                 MerkleBundle_SHA256<uint32_t>, // count could be size_t
                 zk::MerkleAuthPath_SHA256<FR>>(
             treeDepth,
-            leafNumber);
+            leafNumber,
+            leafCount);
 
     } else if ("512" == shaBits) {
         runTest<PAIRING,
                 MerkleBundle_SHA512<uint64_t>, // count could be size_t
                 zk::MerkleAuthPath_SHA512<FR>>(
             treeDepth,
-            leafNumber);
+            leafNumber,
+            leafCount);
+
+    } else if ("mimc" == shaBits) {
+        runTest<PAIRING,
+                MerkleBundle_MiMC<FR, uint32_t>, // count could be size_t
+                zk::MerkleAuthPath_MiMC<FR>>(
+            treeDepth,
+            leafNumber,
+            leafCount);
     }
 
     GenericProgressBar progress1(cerr), progress2(cerr, 100);
@@ -125,9 +351,10 @@ int main(int argc, char *argv[])
 {
     // command line switches
     string pairing, shaBits;
-    size_t treeDepth = -1, leafNumber = -1;
+    bool sparse = false;
+    size_t treeDepth = -1, leafNumber = -1, leafCount = -1, proofCount = 1;
     int opt;
-    while (-1 != (opt = getopt(argc, argv, "p:b:d:i:"))) {
+    while (-1 != (opt = getopt(argc, argv, "p:b:d:i:n:sk:"))) {
         switch (opt) {
         case ('p') :
             pairing = optarg;
@@ -147,6 +374,21 @@ int main(int argc, char *argv[])
                 if (!ss) printUsage(argv[0]);
             }
             break;
+        case('n') : {
+                stringstream ss(optarg);
+                ss >> leafCount;
+                if (!ss) printUsage(argv[0]);
+            }
+            break;
+        case ('s') :
+            sparse = true;
+            break;
+        case('k') : {
+                stringstream ss(optarg);
+                ss >> proofCount;
+                if (!ss || 0 == proofCount) printUsage(argv[0]);
+            }
+            break;
         }
     }
 
@@ -158,12 +400,12 @@ int main(int argc, char *argv[])
     if (pairingBN128(pairing)) {
         // Barreto-Naehrig 128 bits
         init_BN128();
-        result = runTest<BN128_PAIRING>(shaBits, treeDepth, leafNumber);
+        result = runTest<BN128_PAIRING>(shaBits, sparse, treeDepth, leafNumber, leafCount, proofCount);
 
     } else if (pairingEdwards(pairing)) {
         // Edwards 80 bits
         init_Edwards();
-        result = runTest<EDWARDS_PAIRING>(shaBits, treeDepth, leafNumber);
+        result = runTest<EDWARDS_PAIRING>(shaBits, sparse, treeDepth, leafNumber, leafCount, proofCount);
 
     }
 
@@ -35,7 +35,7 @@ int main(int argc, char *argv[])
     typedef BN128_PAIRING PAIRING;
 
     // output hash digest is publicly known
-    const auto pubHash = digest(eval::SHA256(), "abc");
+    constexpr auto pubHash = digest_constexpr<eval::SHA256>("abc");
 
     if ("keygen" == mode) {
 
@@ -28,12 +28,13 @@ void printUsage(const char* exeName) {
 template <typename ZK_SHA, typename EVAL_SHA>
 bool runTest(const bool stdInput)
 {
-    DataBufferStream buf;
+    DataBufferStream buf, text;
 
     if (stdInput) {
         // fill message block(s) from standard input
         cin >> buf;
 
+        text = buf;
         ZK_SHA::padMessage(buf);
 
     } else {
@@ -71,6 +72,18 @@ bool runTest(const bool stdInput)
         }
     }
 
+    // streaming digest pads the text itself
+    if (stdInput) {
+        EVAL_SHA hashAlgo;
+        hashAlgo.update(text);
+        hashAlgo.finalize();
+
+        if (hashAlgo.digest() != eval_digest) {
+            ok = false;
+            cout << "streaming digest error" << endl;
+        }
+    }
+
     // message digest proof constraint
     assert_true(zk_digest == eval_digest);
 